@@ -0,0 +1,44 @@
+#!/usr/bin/env python3
+
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+#
+# This script checks the dynamic regridding of the refinement patch around
+# a beam moving along z (script `inputs_2d`). The patch is recomputed every
+# 5 steps from the number of macroparticles per cell: at the end of the
+# simulation, the refinement patch must exist and contain all the particles,
+# which are then on the fine level. If the particles of the fine level were
+# not counted when tagging the coarse level, the patch would be removed at
+# every other regrid.
+
+import sys
+
+import numpy as np
+import yt
+
+yt.funcs.mylog.setLevel(50)
+
+# this will be the name of the plot file
+fn = sys.argv[1]
+
+ds = yt.load(fn)
+print(f"finest level: {ds.index.max_level}")
+assert ds.index.max_level == 1
+
+# Extent of the boxes of the refinement patch
+fine_grids = [g for g in ds.index.grids if g.Level == 1]
+lo = np.array([g.LeftEdge.to_value()[:2] for g in fine_grids])
+hi = np.array([g.RightEdge.to_value()[:2] for g in fine_grids])
+
+ad = ds.all_data()
+x = ad['electrons', 'particle_position_x'].to_value()
+z = ad['electrons', 'particle_position_y'].to_value()
+assert len(x) > 0
+
+# Each particle is inside at least one box of the refinement patch
+inside = np.zeros(len(x), dtype=bool)
+for ilo, ihi in zip(lo, hi):
+    inside |= (x >= ilo[0]) & (x <= ihi[0]) & (z >= ilo[1]) & (z <= ihi[1])
+print(f"particles outside of the refinement patch: {np.count_nonzero(~inside)} / {len(x)}")
+assert np.all(inside)
@@ -164,4 +164,9 @@ if 'phi' in ts.avail_record_components['electron']:
 
 # Checksum regression analysis
 test_name = os.path.split(os.getcwd())[1]
-checksumAPI.evaluate_checksum(test_name, filename)
+if re.search('grouped_solves', filename):
+    # The electrons (at rest on average) and the boundary potentials share one Poisson
+    # solve, instead of two in ElectrostaticSphere: the fields are the same
+    checksumAPI.evaluate_checksum('ElectrostaticSphere', filename, rtol=1.e-8)
+else:
+    checksumAPI.evaluate_checksum(test_name, filename)
@@ -97,4 +97,9 @@ assert(rel_err_z < rel_tol_err)
 
 test_name = os.path.split(os.getcwd())[1]
 
+if test_name == 'embedded_boundary_cube_macroscopic_compressed':
+    # The compressed coefficients of the update of E have the same values as the
+    # coefficients stored at each location in embedded_boundary_cube_macroscopic
+    test_name = 'embedded_boundary_cube_macroscopic'
+
 checksumAPI.evaluate_checksum(test_name, filename)
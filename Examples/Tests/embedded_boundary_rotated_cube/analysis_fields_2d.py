@@ -62,4 +62,10 @@ assert (rel_err_y < rel_tol_err)
 
 test_name = os.path.split(os.getcwd())[1]
 
+if test_name == 'embedded_boundary_rotated_cube_2d_load_balance':
+    # The face extensions depend on the decomposition of the domain in boxes, which is
+    # not the same as in embedded_boundary_rotated_cube_2d: the results are only
+    # checked against the theory (above)
+    sys.exit(0)
+
 checksumAPI.evaluate_checksum(test_name, filename)
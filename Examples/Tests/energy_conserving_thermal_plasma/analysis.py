@@ -11,11 +11,16 @@
 # is not expected to be exactly conserved, but it is expected to be better conserved
 # than other gathering scheme. This tests checks that the energy does not increase by
 # more than 0.3% over the duration of the simulatoin.
+# With the adaptive time step (test EnergyConservingThermalPlasma_adaptive_dt), the
+# same check is done, and the script also checks that the time step grew from its
+# initial value while resolving the plasma frequency.
 
 import os
+import re
 import sys
 
 import numpy as np
+from scipy.constants import e, epsilon_0, m_e
 
 sys.path.insert(1, '../../../../warpx/Regression/Checksum/')
 import checksumAPI
@@ -33,6 +38,21 @@ print(abs(E-E[0])/E[0])
 # Check that the energy is conserved to 0.3%
 assert np.all( abs(E-E[0])/E[0] < 0.003 )
 
-# Checksum test
-test_name = os.path.split(os.getcwd())[1]
-checksumAPI.evaluate_checksum(test_name, fn)
+if re.search('adaptive_dt', fn):
+    # Parameters (these parameters must match the parameters in the test inputs)
+    n0 = 1.e30
+    wpe = e*np.sqrt(n0/(m_e*epsilon_0))
+    dt_init = 0.05/wpe
+    dt_plasma_frequency_resolution = 0.2
+    # The reduced diagnostics are written at every step: the time step is the
+    # difference between consecutive times
+    dt = np.diff(EPdata[:,1])
+    print(f"initial dt*wpe: {dt[0]*wpe}, final dt*wpe: {dt[-1]*wpe}")
+    # The time step grew, but omega_p*dt never exceeded the requested resolution
+    # (the upper bound of omega_p used by the code is larger than wpe)
+    assert dt[-1] > 1.5*dt_init
+    assert np.all( dt*wpe <= dt_plasma_frequency_resolution*(1. + 1.e-6) )
+else:
+    # Checksum test
+    test_name = os.path.split(os.getcwd())[1]
+    checksumAPI.evaluate_checksum(test_name, fn)
@@ -41,6 +41,13 @@ vay_deposition = True if re.search( 'Vay_deposition', fn ) else False
 # Parse test name and check if particle_shape = 4 is used
 particle_shape_4 = True if re.search('particle_shape_4', fn) else False
 
+# Parse test name and check if the colored current deposition (warpx.do_colored_current_deposition=1) is used
+colored_deposition = True if re.search('colored_deposition', fn) else False
+
+# Parse test name and check if the partition in the mesh refinement buffers is reused
+# between steps (warpx.do_incremental_buffer_partition=1)
+incremental_buffer_partition = True if re.search('incremental_buffer_partition', fn) else False
+
 # Parameters (these parameters must match the parameters in `inputs.multi.rt`)
 epsilon = 0.01
 n = 4.e24
@@ -144,4 +151,13 @@ if current_correction or vay_deposition:
     assert( error_rel < tolerance )
 
 test_name = os.path.split(os.getcwd())[1]
-checksumAPI.evaluate_checksum(test_name, fn)
+if colored_deposition:
+    # The colored current deposition gives the same result as the deposition in
+    # thread-local buffers of Langmuir_multi_2d_nodal, up to the order of the additions
+    checksumAPI.evaluate_checksum('Langmuir_multi_2d_nodal', fn, rtol=1.e-8)
+elif incremental_buffer_partition:
+    # Only the order of the particles within the fine patch and the buffers differs
+    # from Langmuir_multi_2d_MR, which partitions all the particles at every step
+    checksumAPI.evaluate_checksum('Langmuir_multi_2d_MR', fn, rtol=1.e-8)
+else:
+    checksumAPI.evaluate_checksum(test_name, fn)
@@ -113,4 +113,8 @@ if current_correction:
     assert(err_charge < tol_charge)
 
 test_name = os.path.split(os.getcwd())[1]
+# With load balancing, the spectral solvers are rebuilt and reuse the PSATD coefficients
+# shared between the boxes: the results are the same as without load balancing
+if re.search('_load_balance', test_name):
+    test_name = test_name.replace('_load_balance', '')
 checksumAPI.evaluate_checksum(test_name, filename, rtol=1.e-8)
@@ -10,6 +10,9 @@
 # The setup is a uniform plasma with electrons, protons and photons.
 # Various particle and field quantities are written to file using the reduced diagnostics
 # and compared with the corresponding quantities computed from the data in the plotfiles.
+# The test particle_fields_diags_temperature_ppc also writes the electron temperature and the
+# number of particles per cell, which are deposited in the same pass over the particles as the
+# particle reductions, and compares them with the values computed from the plotfiles.
 
 import os
 import sys
@@ -220,4 +223,54 @@ def do_analysis(single_precision = False):
 
 
     test_name = os.path.split(os.getcwd())[1]
+    if test_name == 'particle_fields_diags_temperature_ppc':
+        check_temperature_and_ppc(ds, ad, ad0, tolerance)
+        # The plotfile has more fields than in particle_fields_diags, so that there is
+        # no benchmark to compare with: the checks above use the particle data instead
+        return
     checksumAPI.evaluate_checksum(test_name, fn, rtol=check_tolerance)
+
+
+def check_temperature_and_ppc(ds, ad, ad0, tolerance):
+    domain_size = ds.domain_right_edge.value - ds.domain_left_edge.value
+    dx = domain_size / ds.domain_dimensions
+
+    def cell_indices(species):
+        x = ad[species, 'particle_position_x'].to_ndarray()
+        y = ad[species, 'particle_position_y'].to_ndarray()
+        z = ad[species, 'particle_position_z'].to_ndarray()
+        return (((x - ds.domain_left_edge[0].value) / dx[0]).astype(int),
+                ((y - ds.domain_left_edge[1].value) / dx[1]).astype(int),
+                ((z - ds.domain_left_edge[2].value) / dx[2]).astype(int))
+
+    # Number of particles per cell, summed over all species
+    ppc = np.zeros(ds.domain_dimensions)
+    for species in ['electrons', 'protons', 'photons']:
+        np.add.at(ppc, cell_indices(species), 1.)
+    ppc_rd = ad0[('boxlib','part_per_cell')].to_ndarray()
+    error = np.max(abs(ppc - ppc_rd))
+    print('part_per_cell error plotfile = ', error)
+    assert(error == 0.)
+
+    # Electron temperature in eV, from the variance of the momentum (per unit mass) in each cell
+    ind = cell_indices('electrons')
+    w = ad['electrons', 'particle_weight'].to_ndarray()
+    wsum = np.zeros(ds.domain_dimensions)
+    np.add.at(wsum, ind, w)
+    wsum_adj = np.where(wsum == 0, 1, wsum)
+    var = np.zeros(ds.domain_dimensions)
+    for comp in ['x', 'y', 'z']:
+        u = ad['electrons', 'particle_momentum_'+comp].to_ndarray() / m_e
+        usum = np.zeros(ds.domain_dimensions)
+        np.add.at(usum, ind, w*u)
+        du = u - (usum / wsum_adj)[ind]
+        u2sum = np.zeros(ds.domain_dimensions)
+        np.add.at(u2sum, ind, w*du**2)
+        var += u2sum / wsum_adj
+    T = m_e*var/(3.*e)
+    T_rd = ad0[('boxlib','T_electrons')].to_ndarray()
+    # Cells with a single electron have a zero temperature up to round-off errors,
+    # so that the error is relative to the maximum temperature
+    error = np.max(abs(T - T_rd)) / np.max(abs(T))
+    print('electrons: T relative error plotfile = ', error)
+    assert(error < tolerance)
@@ -8,6 +8,7 @@
 # -*- coding: utf-8 -*-
 
 import os
+import re
 import sys
 
 import yt
@@ -57,6 +58,20 @@ def main():
     ac.check(dt, particle_data)
 
     test_name = os.path.split(os.getcwd())[1]
+    if re.search('distributed_tables', test_name):
+        # The lookup tables are generated instead of built-in, so that the results can only
+        # be checked against the theory (above), not against the benchmark of qed_breit_wheeler_2d
+        return
+    if re.search('compact_tables', test_name):
+        # The single precision copies of the tables only change the rates and the momenta
+        # of the created particles by round-off errors compared to qed_breit_wheeler_2d
+        checksumAPI.evaluate_checksum('qed_breit_wheeler_2d', filename_end, rtol=1.e-5)
+        return
+    if re.search('rate_update', test_name):
+        # The fields are constant, so that the photons reuse the rate of the first step:
+        # the optical depths only differ by round-off errors from qed_breit_wheeler_2d
+        checksumAPI.evaluate_checksum('qed_breit_wheeler_2d', filename_end, rtol=1.e-8)
+        return
     checksumAPI.evaluate_checksum(test_name, filename_end)
 
 if __name__ == "__main__":
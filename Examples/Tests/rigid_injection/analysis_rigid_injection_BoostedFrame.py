@@ -82,4 +82,9 @@ print(f'tolerance = {tol}')
 assert(err < tol)
 
 test_name = os.path.split(os.getcwd())[1]
-checksumAPI.evaluate_checksum(test_name, filename)
+if test_name == "RigidInjection_BTD_selective_copy":
+    # The selective copy only changes which particles have their data saved before
+    # the push: the back-transformed data is the same as in RigidInjection_BTD
+    checksumAPI.evaluate_checksum("RigidInjection_BTD", filename)
+else:
+    checksumAPI.evaluate_checksum(test_name, filename)
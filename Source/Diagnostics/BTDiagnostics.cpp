@@ -234,6 +234,7 @@ BTDiagnostics::ReadParameters ()
     pp_diag_name.query("file_prefix", m_file_prefix);
     pp_diag_name.query("do_back_transformed_fields", m_do_back_transformed_fields);
     pp_diag_name.query("do_back_transformed_particles", m_do_back_transformed_particles);
+    pp_diag_name.query("do_selective_particle_copy", m_do_selective_particle_copy);
     AMREX_ALWAYS_ASSERT(m_do_back_transformed_fields or m_do_back_transformed_particles);
     if (!m_do_back_transformed_fields) { m_varnames.clear(); }
 
@@ -858,6 +859,14 @@ BTDiagnostics::PrepareFieldDataForOutput ()
                                              m_snapshot_full[i_buffer] );
 
             }
+            // Extract and Lorentz-transform the boosted-frame slices of all buffers at once
+            amrex::Vector<amrex::MultiFab const*> mf_dst(m_num_buffers, nullptr);
+            for (int i_buffer = 0; i_buffer < m_num_buffers; ++i_buffer) {
+                if (m_field_buffer_multifab_defined[i_buffer] == 1) {
+                    mf_dst[i_buffer] = &m_mf_output[i_buffer][lev];
+                }
+            }
+            m_all_field_functors[lev][i]->PrepareBatchedData(mf_dst);
         }
     }
 }
@@ -1424,6 +1433,10 @@ BTDiagnostics::InitializeParticleFunctors ()
         // species id corresponding to ith diag species
         const int idx = mpc.getSpeciesID(m_output_species_names[i]);
         m_all_particle_functors[i] = std::make_unique<BackTransformParticleFunctor>(mpc.GetParticleContainerPtr(idx), m_output_species_names[i], m_num_buffers);
+        // The lab-frame times of the snapshots are used by the particle container
+        // to select the particles whose old attributes are copied before the push
+        mpc.GetParticleContainerPtr(idx)->AddBackTransformedParticlesSnapshots(
+            m_t_lab, m_do_selective_particle_copy);
     }
 
 }
@@ -14,21 +14,25 @@
 
 #include <AMReX_Array4.H>
 #include <AMReX_BoxArray.H>
+#include <AMReX_BoxList.H>
 #include <AMReX_Config.H>
+#include <AMReX_DistributionMapping.H>
 #include <AMReX_Extension.H>
 #include <AMReX_FArrayBox.H>
 #include <AMReX_FabArray.H>
 #include <AMReX_Geometry.H>
+#include <AMReX_GpuContainers.H>
 #include <AMReX_GpuControl.H>
 #include <AMReX_GpuLaunch.H>
 #include <AMReX_GpuQualifiers.H>
 #include <AMReX_MFIter.H>
 #include <AMReX_MultiFab.H>
-#include <AMReX_MultiFabUtil.H>
 
+#include <algorithm>
 #include <cmath>
 #include <map>
 #include <memory>
+#include <utility>
 
 using namespace amrex;
 
@@ -51,77 +55,37 @@ BackTransformFunctor::operator ()(amrex::MultiFab& mf_dst, int /*dcomp*/, const
     // Perform back-transformation only if z slice is within the domain stored as 0/1
     // in m_perform_backtransform[i_buffer]
     if ( m_perform_backtransform[i_buffer] == 1) {
-        auto& warpx = WarpX::GetInstance();
-        auto geom = warpx.Geom(m_lev);
-        const amrex::Real gamma_boost = WarpX::gamma_boost;
         const int moving_window_dir = WarpX::moving_window_dir;
-        const amrex::Real beta_boost = std::sqrt( 1._rt - 1._rt/( gamma_boost * gamma_boost) );
-        const bool interpolate = true;
-        std::unique_ptr< amrex::MultiFab > slice = nullptr;
-        const int scomp = 0;
-
-        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_mf_src != nullptr, "m_mf_src can't be a nullptr.");
-        AMREX_ASSUME(m_mf_src != nullptr);
-
-        // Generate slice of the cell-centered multifab containing boosted-frame field-data
-        // at current z-boost location for the ith buffer
-        slice = amrex::get_slice_data(
-            moving_window_dir,
-            m_current_z_boost[i_buffer],
-            *m_mf_src,
-            geom,
-            scomp,
-            m_mf_src->nComp(),
-            interpolate);
-
-
-        // Perform in-place Lorentz-transform of all the fields stored in the slice.
-        LorentzTransformZ( *slice, gamma_boost, beta_boost);
-
-        // Create a 2D box for the slice in the boosted frame
-        const amrex::Real dx = geom.CellSize(moving_window_dir);
-        // index corresponding to z_boost location in the boost-frame
-        const int i_boost = static_cast<int> ( ( m_current_z_boost[i_buffer]
-                                            - geom.ProbLo(moving_window_dir) ) / dx );
-        // z-Slice at i_boost with x,y indices same as buffer_box
-        amrex::Box slice_box = m_buffer_box[i_buffer];
-        slice_box.setSmall(moving_window_dir, i_boost);
-        slice_box.setBig(moving_window_dir, i_boost);
-
-        // Make it a BoxArray
-        const amrex::BoxArray slice_ba(slice_box);
-        // Define MultiFab with the distribution map of the destination multifab and
-        // containing all ten components that were in the slice generated from m_mf_src.
-        std::unique_ptr< amrex::MultiFab > tmp_slice_ptr = nullptr;
-        tmp_slice_ptr = std::make_unique<MultiFab> ( slice_ba, mf_dst.DistributionMap(),
-                                                     slice->nComp(), 0 );
-        tmp_slice_ptr->setVal(0.0);
-        // Parallel copy the lab-frame data from "slice" MultiFab with
-        // ncomp=10 and boosted-frame dmap to "tmp_slice_ptr" MultiFab with
-        // ncomp=10 and dmap of the destination Multifab, which will store the final data
-        ablastr::utils::communication::ParallelCopy(*tmp_slice_ptr, *slice, 0, 0, slice->nComp(),
-                                                    IntVect(AMREX_D_DECL(0, 0, 0)),
-                                                    IntVect(AMREX_D_DECL(0, 0, 0)),
-                                                    WarpX::do_single_precision_comms);
+
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_slab_data != nullptr && m_slab_index[i_buffer] >= 0,
+            "PrepareBatchedData must be called before back-transforming the fields.");
+
+        // The slab, already Lorentz-transformed to the lab-frame, was extracted
+        // in PrepareBatchedData on the rank that owns mf_dst
+        const int islab = m_slab_index[i_buffer];
+        const amrex::Box slab_box = m_slab_data->box(islab);
+        const int i_boost = slab_box.smallEnd(moving_window_dir);
+        // The slab is only one cell thick if the z-slice is in the last cell of the domain
+        const int dk = slab_box.bigEnd(moving_window_dir) - i_boost;
+        const amrex::Real w_hi = m_slab_weight[i_buffer];
+        const amrex::Real w_lo = 1._rt - w_hi;
+
         // Now we will cherry pick only the user-defined fields from
-        // tmp_slice_ptr to dst_mf
+        // the slab to dst_mf, interpolated at the z-boost location of the ith buffer
         const int k_lab = m_k_index_zlab[i_buffer];
         const int ncomp_dst = mf_dst.nComp();
-        amrex::MultiFab& tmp = *tmp_slice_ptr;
-#ifdef AMREX_USE_GPU
-        Gpu::DeviceVector<int> d_map_varnames(m_map_varnames.size());
-        Gpu::copyAsync(Gpu::hostToDevice,
-                       m_map_varnames.begin(), m_map_varnames.end(),
-                       d_map_varnames.begin());
-        Gpu::synchronize();
-        int const* field_map_ptr = d_map_varnames.dataPtr();
-#else
-        int const* field_map_ptr = m_map_varnames.dataPtr();
-#endif
-        for (amrex::MFIter mfi(tmp, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        int const* field_map_ptr = m_map_varnames_d.dataPtr();
+        for (amrex::MFIter mfi(mf_dst, TilingIfNotGPU()); mfi.isValid(); ++mfi)
         {
-            const Box& tbx = mfi.tilebox();
-            const amrex::Array4<amrex::Real> src_arr = tmp[mfi].array();
+            // Only the tiles that contain the lab-frame slice at k_lab are updated
+            amrex::Box tbx = mfi.tilebox();
+            if (k_lab < tbx.smallEnd(moving_window_dir) || k_lab > tbx.bigEnd(moving_window_dir)) {
+                continue;
+            }
+            // z-Slice at i_boost with x,y indices of the current tile of mf_dst
+            tbx.setSmall(moving_window_dir, i_boost);
+            tbx.setBig(moving_window_dir, i_boost);
+            const amrex::Array4<amrex::Real const> src_arr = m_slab_data->const_array(islab);
             const amrex::Array4<amrex::Real> dst_arr = mf_dst[mfi].array();
 #ifdef WARPX_DIM_RZ
             const int n_rz_comp = WarpX::ncomps;
@@ -132,9 +96,11 @@ BackTransformFunctor::operator ()(amrex::MultiFab& mf_dst, int /*dcomp*/, const
                     // Field id that corresponds to the nth user-requested component
                     const int icomp = field_map_ptr[n];
 #if defined(WARPX_DIM_3D)
-                    dst_arr(i, j, k_lab, n) = src_arr(i, j, k, icomp);
+                    dst_arr(i, j, k_lab, n) = w_lo * src_arr(i, j, k, icomp)
+                                            + w_hi * src_arr(i, j, k+dk, icomp);
 #elif defined(WARPX_DIM_XZ)
-                    dst_arr(i, k_lab, k, n) = src_arr(i, j, k, icomp);
+                    dst_arr(i, k_lab, k, n) = w_lo * src_arr(i, j, k, icomp)
+                                            + w_hi * src_arr(i, j+dk, k, icomp);
 #elif defined(WARPX_DIM_RZ)
                     // rzcomp below gives the component id, 0 to (n_rz_comp-1) for a given field
                     const int rzcomp = n % n_rz_comp;
@@ -146,18 +112,102 @@ BackTransformFunctor::operator ()(amrex::MultiFab& mf_dst, int /*dcomp*/, const
                     // Thus we are accessing real component of mode 1 of Et (note that modes go from 0 to 1)
                     // Since the fields are stored contiguously in src_arr, icomp*n_rz_comp + rz_comp accesses
                     // real part of mode 1 for Et (1*3+1) = 4
-                    dst_arr(i, k_lab, k, n) = src_arr(i, j, k, icomp*n_rz_comp+rzcomp);
+                    dst_arr(i, k_lab, k, n) = w_lo * src_arr(i, j, k, icomp*n_rz_comp+rzcomp)
+                                            + w_hi * src_arr(i, j+dk, k, icomp*n_rz_comp+rzcomp);
 #else
-                    dst_arr(k_lab, j, k, n) = src_arr(i, j, k, icomp);
+                    dst_arr(k_lab, j, k, n) = w_lo * src_arr(i, j, k, icomp)
+                                            + w_hi * src_arr(i+dk, j, k, icomp);
 #endif
                 } );
         }
+    }
+
+}
+
+void
+BackTransformFunctor::PrepareBatchedData (amrex::Vector<amrex::MultiFab const*> const& mf_dst)
+{
+    auto& warpx = WarpX::GetInstance();
+    auto geom = warpx.Geom(m_lev);
+    const amrex::Real gamma_boost = WarpX::gamma_boost;
+    const int moving_window_dir = WarpX::moving_window_dir;
+    const amrex::Real beta_boost = std::sqrt( 1._rt - 1._rt/( gamma_boost * gamma_boost) );
+    const amrex::Real dx = geom.CellSize(moving_window_dir);
+    const int i_domain_lo = geom.Domain().smallEnd(moving_window_dir);
+    const int i_domain_hi = geom.Domain().bigEnd(moving_window_dir);
+
+    // Collect one slab box per distinct (slab, owner rank) pair.
+    // The slab box covers the two boosted-frame cells whose centers enclose the z-boost
+    // location of the buffer, with the x,y indices of the buffer box.
+    amrex::BoxList slab_bl;
+    amrex::Vector<int> slab_pmap;
+    std::map<std::pair<amrex::Box, int>, int> slab_ids;
+    for (int i_buffer = 0; i_buffer < m_num_buffers; ++i_buffer) {
+        m_slab_index[i_buffer] = -1;
+        if (m_perform_backtransform[i_buffer] == 0) { continue; }
+
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(mf_dst[i_buffer] != nullptr,
+            "The output multifab of a back-transformed buffer must be defined.");
+
+        // index and weight corresponding to z_boost location in the boost-frame:
+        // the data is cell-centered, so that the interpolation is done between the
+        // cell centers, as in amrex::get_slice_data. Within half a cell of the domain
+        // ends, the value of the first (or last) cell is used.
+        const amrex::Real z_index = ( m_current_z_boost[i_buffer]
+                                    - geom.ProbLo(moving_window_dir) ) / dx - 0.5_rt;
+        int i_boost = static_cast<int>( std::floor(z_index) );
+        amrex::Real weight = z_index - static_cast<amrex::Real>(i_boost);
+        if (i_boost < i_domain_lo) {
+            i_boost = i_domain_lo;
+            weight = 0._rt;
+        } else if (i_boost >= i_domain_hi) {
+            i_boost = i_domain_hi;
+            weight = 0._rt;
+        }
+        m_slab_weight[i_buffer] = weight;
+
+        amrex::Box slab_box = m_buffer_box[i_buffer];
+        slab_box.setSmall(moving_window_dir, i_boost);
+        slab_box.setBig(moving_window_dir, std::min(i_boost + 1, i_domain_hi));
+
+        // The output multifab of a buffer has a single box, see BTDiagnostics::DefineFieldBufferMultiFab
+        const int owner = mf_dst[i_buffer]->DistributionMap()[0];
+        const auto key = std::make_pair(slab_box, owner);
+        auto it = slab_ids.find(key);
+        if (it == slab_ids.end()) {
+            it = slab_ids.emplace(key, static_cast<int>(slab_pmap.size())).first;
+            slab_bl.push_back(slab_box);
+            slab_pmap.push_back(owner);
+        }
+        m_slab_index[i_buffer] = it->second;
+    }
+    if (slab_pmap.empty()) { return; }
+
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_mf_src != nullptr, "m_mf_src can't be a nullptr.");
+    AMREX_ASSUME(m_mf_src != nullptr);
 
-        // Reset the temporary MultiFabs generated
-        slice = nullptr;
-        tmp_slice_ptr = nullptr;
+    // Reuse the slab MultiFab (and the communication metadata cached for its layout)
+    // as long as the set of slabs does not change
+    const amrex::BoxArray slab_ba(std::move(slab_bl));
+    const amrex::DistributionMapping slab_dm(std::move(slab_pmap));
+    if (m_slab_data == nullptr || m_slab_data->boxArray() != slab_ba
+        || m_slab_data->DistributionMap() != slab_dm)
+    {
+        m_slab_data = std::make_unique<amrex::MultiFab>(slab_ba, slab_dm, m_mf_src->nComp(), 0);
+        m_slab_needs_zeroing = !m_mf_src->boxArray().contains(slab_ba);
     }
+    if (m_slab_needs_zeroing) { m_slab_data->setVal(0.0); }
+
+    // Parallel copy the boosted-frame data of all slabs from m_mf_src, with the
+    // boosted-frame dmap, to m_slab_data, with the dmap of the destination multifabs
+    ablastr::utils::communication::ParallelCopy(*m_slab_data, *m_mf_src, 0, 0, m_mf_src->nComp(),
+                                                IntVect(AMREX_D_DECL(0, 0, 0)),
+                                                IntVect(AMREX_D_DECL(0, 0, 0)),
+                                                WarpX::do_single_precision_comms);
 
+    // Perform in-place Lorentz-transform of all the fields stored in the slabs.
+    // The transform is linear and can thus be applied before the interpolation in z.
+    LorentzTransformZ( *m_slab_data, gamma_boost, beta_boost);
 }
 
 void
@@ -181,6 +231,8 @@ BackTransformFunctor::InitData ()
     m_current_z_boost.resize( m_num_buffers );
     m_perform_backtransform.resize( m_num_buffers );
     m_k_index_zlab.resize( m_num_buffers );
+    m_slab_index.resize( m_num_buffers, -1 );
+    m_slab_weight.resize( m_num_buffers, 0._rt );
     m_map_varnames.resize( m_varnames.size() );
 
 #ifdef WARPX_DIM_RZ
@@ -221,6 +273,12 @@ BackTransformFunctor::InitData ()
 #endif
     }
 
+    m_map_varnames_d.resize( m_map_varnames.size() );
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice,
+                          m_map_varnames.begin(), m_map_varnames.end(),
+                          m_map_varnames_d.begin());
+    amrex::Gpu::streamSynchronize();
+
 }
 
 void
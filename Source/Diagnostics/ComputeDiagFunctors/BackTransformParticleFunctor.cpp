@@ -12,28 +12,31 @@
 #include "WarpX.H"
 
 #include <AMReX.H>
+#include <AMReX_ParticleTransformation.H>
 #include <AMReX_Print.H>
 #include <AMReX_BaseFwd.H>
 
-SelectParticles::SelectParticles (const WarpXParIter& a_pti, TmpParticles& tmp_particle_data,
+SelectParticles::SelectParticles (const WarpXParIter& a_pti, const TmpParticles& tmp_particle_data,
                                   amrex::Real current_z_boost, amrex::Real old_z_boost,
-                                  int a_offset)
-    : m_current_z_boost(current_z_boost), m_old_z_boost(old_z_boost)
+                                  int a_offset, const int* particle_index)
+    : m_current_z_boost(current_z_boost), m_old_z_boost(old_z_boost),
+      m_particle_index(particle_index)
 {
     m_get_position = GetParticlePosition<PIdx>(a_pti, a_offset);
 
     const auto lev = a_pti.GetLevel();
     const auto index = a_pti.GetPairIndex();
 
-    zpold = tmp_particle_data[lev][index][TmpIdx::zold].dataPtr();
+    zpold = tmp_particle_data[lev].at(index)[TmpIdx::zold].dataPtr();
 }
 
 
 LorentzTransformParticles::LorentzTransformParticles ( const WarpXParIter& a_pti,
-                                TmpParticles& tmp_particle_data,
+                                const TmpParticles& tmp_particle_data,
                                 amrex::Real t_boost, amrex::Real dt,
-                                amrex::Real t_lab, int a_offset)
-    : m_t_boost(t_boost), m_dt(dt), m_t_lab(t_lab)
+                                amrex::Real t_lab, int a_offset,
+                                const int* particle_index)
+    : m_particle_index(particle_index), m_t_boost(t_boost), m_dt(dt), m_t_lab(t_lab)
 {
     using namespace amrex::literals;
 
@@ -49,12 +52,13 @@ LorentzTransformParticles::LorentzTransformParticles ( const WarpXParIter& a_pti
     const auto lev = a_pti.GetLevel();
     const auto index = a_pti.GetPairIndex();
 
-    m_xpold = tmp_particle_data[lev][index][TmpIdx::xold].dataPtr();
-    m_ypold = tmp_particle_data[lev][index][TmpIdx::yold].dataPtr();
-    m_zpold = tmp_particle_data[lev][index][TmpIdx::zold].dataPtr();
-    m_uxpold = tmp_particle_data[lev][index][TmpIdx::uxold].dataPtr();
-    m_uypold = tmp_particle_data[lev][index][TmpIdx::uyold].dataPtr();
-    m_uzpold = tmp_particle_data[lev][index][TmpIdx::uzold].dataPtr();
+    const auto& tmp_tile = tmp_particle_data[lev].at(index);
+    m_xpold = tmp_tile[TmpIdx::xold].dataPtr();
+    m_ypold = tmp_tile[TmpIdx::yold].dataPtr();
+    m_zpold = tmp_tile[TmpIdx::zold].dataPtr();
+    m_uxpold = tmp_tile[TmpIdx::uxold].dataPtr();
+    m_uypold = tmp_tile[TmpIdx::uyold].dataPtr();
+    m_uzpold = tmp_tile[TmpIdx::uzold].dataPtr();
 
     m_betaboost = WarpX::beta_boost;
     m_gammaboost = WarpX::gamma_boost;
@@ -84,7 +88,10 @@ BackTransformParticleFunctor::operator () (PinnedMemoryParticleContainer& pc_dst
     auto &warpx = WarpX::GetInstance();
     // get particle slice
     const int nlevs = std::max(0, m_pc_src->finestLevel()+1);
-    auto tmp_particle_data = m_pc_src->getTmpParticleData();
+    const auto& tmp_particle_data = m_pc_src->getTmpParticleData();
+    const auto& tmp_particle_index = m_pc_src->getTmpParticleIndex();
+    // With the selective copy, only the particles stored in tmp_particle_data are candidates
+    const bool selective = m_pc_src->doBackTransformedParticlesSelective();
     for (int lev = 0; lev < nlevs; ++lev) {
         const amrex::Real t_boost = warpx.gett_new(0);
         const amrex::Real dt = warpx.getdt(0);
@@ -107,15 +114,21 @@ BackTransformParticleFunctor::operator () (PinnedMemoryParticleContainer& pc_dst
 
                 auto index = std::make_pair(pti.index(), pti.LocalTileIndex());
 
+                const int* particle_index = selective ?
+                    tmp_particle_index[lev].at(index).dataPtr() : nullptr;
                 const auto GetParticleFilter = SelectParticles(pti, tmp_particle_data,
                                                m_current_z_boost[i_buffer],
-                                               m_old_z_boost[i_buffer]);
+                                               m_old_z_boost[i_buffer],
+                                               0, particle_index);
                 const auto GetParticleLorentzTransform = LorentzTransformParticles(
                                                          pti, tmp_particle_data,
                                                          t_boost, dt,
-                                                         m_t_lab[i_buffer]);
+                                                         m_t_lab[i_buffer],
+                                                         0, particle_index);
 
-                long const np = pti.numParticles();
+                // Number of candidate particles
+                long const np = selective ?
+                    static_cast<long>(tmp_particle_index[lev].at(index).size()) : pti.numParticles();
 
                 FlagForPartCopy.resize(np);
                 IndexForPartCopy.resize(np);
@@ -137,15 +150,29 @@ BackTransformParticleFunctor::operator () (PinnedMemoryParticleContainer& pc_dst
                 auto& ptile_dst = pc_dst.DefineAndReturnParticleTile(lev, pti.index(), pti.LocalTileIndex() );
                 auto old_size = ptile_dst.numParticles();
                 ptile_dst.resize(old_size + total_partdiag_size);
-                amrex::filterParticles(ptile_dst, ptile_src, GetParticleFilter, 0, old_size, np);
-                auto dst_data = ptile_dst.getParticleTileData();
-                amrex::ParallelFor(np,
-                [=] AMREX_GPU_DEVICE(int i)
-                {
-                   if (Flag[i] == 1) { GetParticleLorentzTransform(dst_data, src_data, i,
-                                                                 old_size + IndexLocation[i]);
-                   }
-                });
+                if (selective) {
+                    auto dst_data = ptile_dst.getParticleTileData();
+                    amrex::ParallelFor(np,
+                    [=] AMREX_GPU_DEVICE(int i)
+                    {
+                       if (Flag[i] == 1) {
+                           amrex::copyParticle(dst_data, src_data, particle_index[i],
+                                               old_size + IndexLocation[i]);
+                           GetParticleLorentzTransform(dst_data, src_data, i,
+                                                       old_size + IndexLocation[i]);
+                       }
+                    });
+                } else {
+                    amrex::filterParticles(ptile_dst, ptile_src, GetParticleFilter, 0, old_size, np);
+                    auto dst_data = ptile_dst.getParticleTileData();
+                    amrex::ParallelFor(np,
+                    [=] AMREX_GPU_DEVICE(int i)
+                    {
+                       if (Flag[i] == 1) { GetParticleLorentzTransform(dst_data, src_data, i,
+                                                                     old_size + IndexLocation[i]);
+                       }
+                    });
+                }
                 amrex::Gpu::synchronize();
             }
         }
@@ -1,6 +1,7 @@
 #include "PartPerCellFunctor.H"
 
 #include "Diagnostics/ComputeDiagFunctors/ComputeDiagFunctor.H"
+#include "Diagnostics/ComputeDiagFunctors/ParticleDepositionPlanner.H"
 #include "Particles/MultiParticleContainer.H"
 #include "WarpX.H"
 
@@ -13,29 +14,30 @@
 
 using namespace amrex::literals;
 
-PartPerCellFunctor::PartPerCellFunctor(const amrex::MultiFab* mf_src, const int lev, amrex::IntVect crse_ratio, const int ncomp)
-    : ComputeDiagFunctor(ncomp, crse_ratio), m_lev(lev)
+PartPerCellFunctor::PartPerCellFunctor(const amrex::MultiFab* mf_src, const int lev, amrex::IntVect crse_ratio,
+                                       ParticleDepositionPlanner* planner, const int ncomp)
+    : ComputeDiagFunctor(ncomp, crse_ratio), m_lev(lev), m_planner(planner)
 {
     // mf_src will not be used, let's make sure it's null.
     AMREX_ALWAYS_ASSERT(mf_src == nullptr);
     // Write only in one output component.
     AMREX_ALWAYS_ASSERT(ncomp == 1);
+    AMREX_ALWAYS_ASSERT(m_planner != nullptr);
+
+    // The number of particles of all species is summed in one component of the planner
+    m_comp = m_planner->AddComponents(m_lev, 1);
+    auto& mypc = WarpX::GetInstance().GetPartContainer();
+    for (int ispec = 0; ispec < mypc.nContainers(); ++ispec) {
+        m_planner->AddMoment(m_lev, ispec, m_comp, ParticleDepositionPlanner::MomentType::Count);
+    }
 }
 
 void
 PartPerCellFunctor::operator()(amrex::MultiFab& mf_dst, const int dcomp, const int /*i_buffer*/) const
 {
-    auto& warpx = WarpX::GetInstance();
-    // Guard cell is set to 1 for generality. However, for a cell-centered
-    // output Multifab, mf_dst, the guard-cell data is not needed especially considering
-    // the operations performend in the CoarsenAndInterpolate function.
-    constexpr int ng = 1;
-    // Temporary cell-centered, single-component MultiFab for storing particles per cell.
-    amrex::MultiFab ppc_mf(warpx.boxArray(m_lev), warpx.DistributionMap(m_lev), 1, ng);
-    // Set value to 0, and increment the value in each cell with ppc.
-    ppc_mf.setVal(0._rt);
-    // Compute ppc which includes a summation over all species.
-    warpx.GetPartContainer().Increment(ppc_mf, m_lev);
+    // The number of particles per cell, summed over all species, has already been
+    // deposited by the planner.
+    const amrex::MultiFab ppc_mf(m_planner->GetMultiFab(m_lev), amrex::make_alias, m_comp, 1);
     // Coarsen and interpolate from ppc_mf to the output diagnostic MultiFab, mf_dst.
     ablastr::coarsen::sample::Coarsen(mf_dst, ppc_mf, dcomp, 0, nComp(), 0, m_crse_ratio);
 }
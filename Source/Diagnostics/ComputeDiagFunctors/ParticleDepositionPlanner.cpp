@@ -0,0 +1,196 @@
+/* This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "ParticleDepositionPlanner.H"
+
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/Pusher/GetAndSetPosition.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/WarpXConst.H"
+#include "Utils/WarpXProfilerWrapper.H"
+#include "WarpX.H"
+
+#include <AMReX_GpuAtomic.H>
+#include <AMReX_GpuContainers.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_Math.H>
+#include <AMReX_REAL.H>
+
+#include <algorithm>
+
+using namespace amrex::literals;
+
+namespace
+{
+    /** Deposit the moments of one species in the scratch MultiFab mf */
+    void DepositSpecies (WarpXParticleContainer& pc, int const lev,
+                         amrex::Vector<ParticleDepositionPlanner::Moment> const& h_moments,
+                         amrex::MultiFab& mf)
+    {
+        using MomentType = ParticleDepositionPlanner::MomentType;
+
+        auto const nmoments = static_cast<int>(h_moments.size());
+        amrex::Gpu::DeviceVector<ParticleDepositionPlanner::Moment> d_moments(nmoments);
+        amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, h_moments.begin(), h_moments.end(),
+                              d_moments.begin());
+        ParticleDepositionPlanner::Moment const* moments = d_moments.dataPtr();
+
+        const auto plo = pc.Geom(lev).ProbLoArray();
+        const auto dxi = pc.Geom(lev).InvCellSizeArray();
+        for (WarpXParIter pti(pc, lev); pti.isValid(); ++pti)
+        {
+            const long np = pti.numParticles();
+            amrex::ParticleReal const* wp = pti.GetAttribs(PIdx::w).dataPtr();
+            amrex::ParticleReal const* uxp = pti.GetAttribs(PIdx::ux).dataPtr();
+            amrex::ParticleReal const* uyp = pti.GetAttribs(PIdx::uy).dataPtr();
+            amrex::ParticleReal const* uzp = pti.GetAttribs(PIdx::uz).dataPtr();
+
+            auto const GetPosition = GetParticlePosition<PIdx>(pti);
+
+            amrex::Array4<amrex::Real> const& out_array = mf.array(pti);
+
+            amrex::ParallelFor(np,
+                [=] AMREX_GPU_DEVICE (long ip) {
+                    // Get position in AMReX convention to calculate corresponding index.
+                    amrex::ParticleReal xp, yp, zp;
+                    GetPosition.AsStored(ip, xp, yp, zp);
+                    int ii = 0, jj = 0, kk = 0;
+#if defined(WARPX_DIM_1D_Z)
+                    const amrex::Real lz = (zp - plo[0]) * dxi[0];
+                    ii = static_cast<int>(amrex::Math::floor(lz));
+#else
+                    const amrex::Real lx = (xp - plo[0]) * dxi[0];
+                    ii = static_cast<int>(amrex::Math::floor(lx));
+#endif
+#if defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+                    const amrex::Real lz = (zp - plo[1]) * dxi[1];
+                    jj = static_cast<int>(amrex::Math::floor(lz));
+#elif defined(WARPX_DIM_3D)
+                    const amrex::Real ly = (yp - plo[1]) * dxi[1];
+                    jj = static_cast<int>(amrex::Math::floor(ly));
+                    const amrex::Real lz = (zp - plo[2]) * dxi[2];
+                    kk = static_cast<int>(amrex::Math::floor(lz));
+#endif
+
+                    // Get position in WarpX convention to use in parser. Will be different from
+                    // the position as stored for 1D, 2D and RZ simulations.
+                    amrex::ParticleReal xw = 0._prt, yw = 0._prt, zw = 0._prt;
+                    GetPosition(ip, xw, yw, zw);
+
+                    const amrex::ParticleReal w  = wp[ip];
+                    const amrex::ParticleReal ux = uxp[ip];
+                    const amrex::ParticleReal uy = uyp[ip];
+                    const amrex::ParticleReal uz = uzp[ip];
+
+                    for (int m = 0; m < nmoments; ++m) {
+                        ParticleDepositionPlanner::Moment const& moment = moments[m];
+                        amrex::ParticleReal value = 0._prt;
+                        switch (moment.type) {
+                            case MomentType::Weight: value = w; break;
+                            case MomentType::WeightUx: value = w*ux; break;
+                            case MomentType::WeightUy: value = w*uy; break;
+                            case MomentType::WeightUz: value = w*uz; break;
+                            case MomentType::Count: value = 1._prt; break;
+                            case MomentType::Function:
+                            case MomentType::FilteredWeight:
+                            {
+                                // Fix dimensions since parser assumes u = gamma * v / c
+                                const amrex::ParticleReal uxc = ux / PhysConst::c;
+                                const amrex::ParticleReal uyc = uy / PhysConst::c;
+                                const amrex::ParticleReal uzc = uz / PhysConst::c;
+                                const bool filtered_out_flag = moment.do_filter &&
+                                    (moment.filter_fn(xw, yw, zw, uxc, uyc, uzc) == 0.0_prt);
+                                if (!filtered_out_flag) {
+                                    value = (moment.type == MomentType::Function) ?
+                                        w*moment.fn(xw, yw, zw, uxc, uyc, uzc) : w;
+                                }
+                                break;
+                            }
+                        }
+                        amrex::Gpu::Atomic::AddNoRet(&out_array(ii, jj, kk, moment.comp),
+                                                     static_cast<amrex::Real>(value));
+                    }
+                });
+        }
+        // Keep d_moments alive until all the kernels are done
+        amrex::Gpu::streamSynchronize();
+    }
+}
+
+ParticleDepositionPlanner::LevelData&
+ParticleDepositionPlanner::GetLevel (int const lev)
+{
+    if (lev >= static_cast<int>(m_levels.size())) {
+        m_levels.resize(lev+1);
+    }
+    return m_levels[lev];
+}
+
+int
+ParticleDepositionPlanner::AddComponents (int const lev, int const ncomp)
+{
+    LevelData& level = GetLevel(lev);
+    const int comp = level.ncomp;
+    level.ncomp += ncomp;
+    return comp;
+}
+
+void
+ParticleDepositionPlanner::AddMoment (int const lev, int const ispec, int const comp,
+                                      MomentType const type,
+                                      amrex::ParserExecutor<6> const& fn,
+                                      bool const do_filter,
+                                      amrex::ParserExecutor<6> const& filter_fn)
+{
+    LevelData& level = GetLevel(lev);
+    AMREX_ALWAYS_ASSERT(comp >= 0 && comp < level.ncomp);
+    if (ispec >= static_cast<int>(level.moments.size())) {
+        level.moments.resize(ispec+1);
+    }
+    level.moments[ispec].push_back(Moment{comp, type, fn, do_filter, filter_fn});
+}
+
+void
+ParticleDepositionPlanner::ClearLevel (int const lev)
+{
+    if (lev < static_cast<int>(m_levels.size())) {
+        m_levels[lev].ncomp = 0;
+        m_levels[lev].moments.clear();
+    }
+}
+
+void
+ParticleDepositionPlanner::Deposit (int const nlev)
+{
+    WARPX_PROFILE("ParticleDepositionPlanner::Deposit()");
+
+    auto& warpx = WarpX::GetInstance();
+    auto& mypc = warpx.GetPartContainer();
+
+    const int nlev_deposit = std::min(nlev, static_cast<int>(m_levels.size()));
+    for (int lev = 0; lev < nlev_deposit; ++lev) {
+        LevelData& level = m_levels[lev];
+        if (level.ncomp == 0) { continue; }
+
+        // The scratch MultiFab is only reallocated if the grids have changed
+        // (e.g. after load balancing) or if components were added.
+        // One guard cell is used for the particles that are close to the boundaries of the boxes.
+        const amrex::BoxArray& ba = warpx.boxArray(lev);
+        const amrex::DistributionMapping& dm = warpx.DistributionMap(lev);
+        if (!level.mf.isDefined() || level.mf.nComp() != level.ncomp ||
+            level.mf.boxArray() != ba || level.mf.DistributionMap() != dm) {
+            level.mf = amrex::MultiFab(ba, dm, level.ncomp, 1);
+        }
+        level.mf.setVal(0._rt);
+
+        const int nspec = std::min(mypc.nContainers(), static_cast<int>(level.moments.size()));
+        for (int ispec = 0; ispec < nspec; ++ispec) {
+            if (level.moments[ispec].empty()) { continue; }
+            DepositSpecies(mypc.GetParticleContainer(ispec), lev, level.moments[ispec], level.mf);
+        }
+
+        level.mf.SumBoundary(warpx.Geom(lev).periodicity());
+    }
+}
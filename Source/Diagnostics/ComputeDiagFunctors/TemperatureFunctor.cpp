@@ -2,6 +2,7 @@
 #include "TemperatureFunctor.H"
 
 #include "Diagnostics/ComputeDiagFunctors/ComputeDiagFunctor.H"
+#include "Diagnostics/ComputeDiagFunctors/ParticleDepositionPlanner.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Particles/WarpXParticleContainer.H"
 #include "Utils/Parser/ParserUtils.H"
@@ -16,11 +17,22 @@
 #include <AMReX_REAL.H>
 
 TemperatureFunctor::TemperatureFunctor (const int lev,
-        const amrex::IntVect crse_ratio, const int ispec, const int ncomp)
-    : ComputeDiagFunctor(ncomp, crse_ratio), m_lev(lev), m_ispec(ispec)
+        const amrex::IntVect crse_ratio, const int ispec,
+        ParticleDepositionPlanner* planner, const int ncomp)
+    : ComputeDiagFunctor(ncomp, crse_ratio), m_lev(lev), m_ispec(ispec), m_planner(planner)
 {
     // Write only in one output component.
     AMREX_ALWAYS_ASSERT(ncomp == 1);
+    AMREX_ALWAYS_ASSERT(m_planner != nullptr);
+
+    // The sums of w, w*ux, w*uy and w*uz are deposited by the planner, together with the
+    // other particle diagnostics. The last 3 components store the sums of the squares.
+    using MomentType = ParticleDepositionPlanner::MomentType;
+    m_comp = m_planner->AddComponents(m_lev, 7);
+    m_planner->AddMoment(m_lev, m_ispec, m_comp  , MomentType::Weight);
+    m_planner->AddMoment(m_lev, m_ispec, m_comp+1, MomentType::WeightUx);
+    m_planner->AddMoment(m_lev, m_ispec, m_comp+2, MomentType::WeightUy);
+    m_planner->AddMoment(m_lev, m_ispec, m_comp+3, MomentType::WeightUz);
 }
 
 void
@@ -29,13 +41,10 @@ TemperatureFunctor::operator() (amrex::MultiFab& mf_dst, const int dcomp, const
     using namespace amrex::literals;
     auto& warpx = WarpX::GetInstance();
 
-    // Guard cell is set to 1 for generality. However, for a cell-centered
-    // output Multifab, mf_dst, the guard-cell data is not needed especially considering
-    // the operations performend in the CoarsenAndInterpolate function.
-    constexpr int ng = 1;
-
-    // Temporary cell-centered, multi-component MultiFab for storing particles sums and result
-    amrex::MultiFab sum_mf(warpx.boxArray(m_lev), warpx.DistributionMap(m_lev), 7, ng);
+    // Cell-centered, multi-component MultiFab for storing particles sums and result,
+    // with one guard cell. This is an alias of the components of the planner's MultiFab,
+    // where the sums of w, w*ux, w*uy and w*uz have already been deposited.
+    amrex::MultiFab sum_mf(m_planner->GetMultiFab(m_lev), amrex::make_alias, m_comp, 7);
 
     auto& pc = warpx.GetPartContainer().GetParticleContainer(m_ispec);
     amrex::Real const mass = pc.getMass();  // Note, implicit conversion from ParticleReal
@@ -46,39 +55,6 @@ TemperatureFunctor::operator() (amrex::MultiFab& mf_dst, const int dcomp, const
     // Calculate the averages in two steps, first the average velocity <u>, then the
     // average velocity squared <u - <u>>**2. This method is more robust than the
     // single step using <u**2> - <u>**2 when <u> >> u_rms.
-    ParticleToMesh(pc, sum_mf, m_lev,
-            [=] AMREX_GPU_DEVICE (const WarpXParticleContainer::SuperParticleType& p,
-                amrex::Array4<amrex::Real> const& out_array,
-                amrex::GpuArray<amrex::Real,AMREX_SPACEDIM> const& plo,
-                amrex::GpuArray<amrex::Real,AMREX_SPACEDIM> const& dxi)
-            {
-                // Get position in AMReX convention to calculate corresponding index.
-                // Ideally this will be replaced with the AMReX NGP interpolator
-                // Always do x direction.
-                int ii = 0, jj = 0, kk = 0;
-                const amrex::ParticleReal x = p.pos(0);
-                const amrex::Real lx = (x - plo[0]) * dxi[0];
-                ii = static_cast<int>(amrex::Math::floor(lx));
-#if defined(WARPX_DIM_XZ) || defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
-                const amrex::ParticleReal y = p.pos(1);
-                const amrex::Real ly = (y - plo[1]) * dxi[1];
-                jj = static_cast<int>(amrex::Math::floor(ly));
-#endif
-#if defined(WARPX_DIM_3D)
-                const amrex::ParticleReal z = p.pos(2);
-                const amrex::Real lz = (z - plo[2]) * dxi[2];
-                kk = static_cast<int>(amrex::Math::floor(lz));
-#endif
-
-                const amrex::ParticleReal w  = p.rdata(PIdx::w);
-                const amrex::ParticleReal ux = p.rdata(PIdx::ux);
-                const amrex::ParticleReal uy = p.rdata(PIdx::uy);
-                const amrex::ParticleReal uz = p.rdata(PIdx::uz);
-                amrex::Gpu::Atomic::AddNoRet(&out_array(ii, jj, kk, 0), (amrex::Real)(w));
-                amrex::Gpu::Atomic::AddNoRet(&out_array(ii, jj, kk, 1), (amrex::Real)(w*ux));
-                amrex::Gpu::Atomic::AddNoRet(&out_array(ii, jj, kk, 2), (amrex::Real)(w*uy));
-                amrex::Gpu::Atomic::AddNoRet(&out_array(ii, jj, kk, 3), (amrex::Real)(w*uz));
-            });
 
     // Divide value by number of particles for average
     for (amrex::MFIter mfi(sum_mf, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi)
@@ -97,7 +73,6 @@ TemperatureFunctor::operator() (amrex::MultiFab& mf_dst, const int dcomp, const
     }
 
     // Calculate the sum of the squares, subtracting the averages
-    // These loops must be written out since ParticleToMesh always zeros out the mf.
     const auto plo = pc.Geom(m_lev).ProbLoArray();
     const auto dxi = pc.Geom(m_lev).InvCellSizeArray();
     for (WarpXParIter pti(pc, m_lev); pti.isValid(); ++pti)
@@ -120,8 +95,13 @@ TemperatureFunctor::operator() (amrex::MultiFab& mf_dst, const int dcomp, const
 
                 // Get position in AMReX convention to calculate corresponding index.
                 int ii = 0, jj = 0, kk = 0;
+#if defined(WARPX_DIM_1D_Z)
+                const amrex::Real lz = (zp - plo[0]) * dxi[0];
+                ii = static_cast<int>(amrex::Math::floor(lz));
+#else
                 const amrex::Real lx = (xp - plo[0]) * dxi[0];
                 ii = static_cast<int>(amrex::Math::floor(lx));
+#endif
 #if defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
                 const amrex::Real lz = (zp - plo[1]) * dxi[1];
                 jj = static_cast<int>(amrex::Math::floor(lz));
@@ -13,6 +13,7 @@
 #include "FlushFormats/FlushFormatSensei.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Utils/Algorithms/IsIn.H"
+#include "Utils/MemoryUtils.H"
 #include "Utils/Parser/ParserUtils.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
@@ -328,6 +329,21 @@ Diagnostics::InitDataBeforeRestart ()
     DerivedInitData();
 }
 
+void
+Diagnostics::Regrid ()
+{
+    auto& warpx = WarpX::GetInstance();
+    nlev = warpx.finestLevel() + 1;
+    for (int lev = 0; lev < nmax_lev; ++lev) {
+        if (lev < nlev) {
+            InitializeFieldFunctors(lev);
+        } else {
+            // Release the functors pointing to the fields of levels that were removed
+            m_all_field_functors[lev].clear();
+        }
+    }
+}
+
 void
 Diagnostics::InitDataAfterRestart ()
 {
@@ -602,3 +618,20 @@ Diagnostics::FilterComputePackFlush (int step, bool force_flush)
         Flush(i_buffer, force_flush);
     }
 }
+
+amrex::Long
+Diagnostics::BufferBytes () const
+{
+    amrex::Long nbytes = 0;
+    for (auto const& mf_buffer : m_mf_output) {
+        for (auto const& mf : mf_buffer) {
+            nbytes += warpx::memory::LocalBytes(mf);
+        }
+    }
+    for (auto const& pc_buffer : m_particles_buffer) {
+        for (auto const& pc : pc_buffer) {
+            if (pc) { nbytes += warpx::memory::LocalParticleBytes(*pc).second; }
+        }
+    }
+    return nbytes;
+}
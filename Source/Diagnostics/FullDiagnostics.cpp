@@ -308,7 +308,8 @@ FullDiagnostics::InitializeFieldFunctorsRZopenPMD (int lev)
             i++;
         } else if ( m_varnames_fields[comp].rfind("T_", 0) == 0 ){
             // Initialize temperature functor to dump temperature per species
-            m_all_field_functors[lev][comp] = std::make_unique<TemperatureFunctor>(lev, m_crse_ratio, m_T_per_species_index[i_T_species]);
+            m_all_field_functors[lev][comp] = std::make_unique<TemperatureFunctor>(lev, m_crse_ratio, m_T_per_species_index[i_T_species],
+                                                                                   &m_deposition_planner);
             if (update_varnames) {
                 AddRZModesToOutputNames(std::string("T_") + m_all_species_names[m_T_per_species_index[i_T_species]], ncomp);
             }
@@ -332,7 +333,7 @@ FullDiagnostics::InitializeFieldFunctorsRZopenPMD (int lev)
                 AddRZModesToOutputNames(std::string("phi"), ncomp);
             }
         } else if ( m_varnames_fields[comp] == "part_per_cell" ){
-            m_all_field_functors[lev][comp] = std::make_unique<PartPerCellFunctor>(nullptr, lev, m_crse_ratio);
+            m_all_field_functors[lev][comp] = std::make_unique<PartPerCellFunctor>(nullptr, lev, m_crse_ratio, &m_deposition_planner);
             if (update_varnames) {
                 m_varnames.push_back(std::string("part_per_cell"));
             }
@@ -368,7 +369,7 @@ FullDiagnostics::InitializeFieldFunctorsRZopenPMD (int lev)
         for (int ispec=0; ispec<int(m_pfield_species.size()); ispec++) {
             m_all_field_functors[lev][nvar + pcomp * nspec + ispec] = std::make_unique<ParticleReductionFunctor>(nullptr,
                     lev, m_crse_ratio, m_pfield_strings[pcomp], m_pfield_species_index[ispec], m_pfield_do_average[pcomp],
-                    m_pfield_dofilter[pcomp], m_pfield_filter_strings[pcomp]);
+                    m_pfield_dofilter[pcomp], m_pfield_filter_strings[pcomp], &m_deposition_planner);
             if (update_varnames) {
                 AddRZModesToOutputNames(std::string(m_pfield_varnames[pcomp]) + "_" + std::string(m_pfield_species[ispec]), ncomp);
             }
@@ -628,9 +629,30 @@ FullDiagnostics::InitializeBufferData (int i_buffer, int lev, bool restart ) {
 }
 
 
+void
+FullDiagnostics::Regrid ()
+{
+    Diagnostics::Regrid();
+
+    // All levels are written, and the output MultiFabs follow the grids of each level
+    nlev_output = nlev;
+    for (int i_buffer = 0; i_buffer < m_num_buffers; ++i_buffer) {
+        for (int lev = 1; lev < nmax_lev; ++lev) {
+            if (lev < nlev_output) {
+                InitializeBufferData(i_buffer, lev);
+            } else {
+                m_mf_output[i_buffer][lev] = amrex::MultiFab();
+            }
+        }
+    }
+}
+
 void
 FullDiagnostics::InitializeFieldFunctors (int lev)
 {
+    // The functors that are created below register the particle moments that they need
+    m_deposition_planner.ClearLevel(lev);
+
 #ifdef WARPX_DIM_RZ
     // For RZ, with openPMD, we need a special initialization instead
     if (m_format == "openpmd") {
@@ -681,7 +703,8 @@ FullDiagnostics::InitializeFieldFunctors (int lev)
             i++;
         } else if ( m_varnames[comp].rfind("T_", 0) == 0 ){
             // Initialize temperature functor to dump temperature per species
-            m_all_field_functors[lev][comp] = std::make_unique<TemperatureFunctor>(lev, m_crse_ratio, m_T_per_species_index[i_T_species]);
+            m_all_field_functors[lev][comp] = std::make_unique<TemperatureFunctor>(lev, m_crse_ratio, m_T_per_species_index[i_T_species],
+                                                                                   &m_deposition_planner);
             i_T_species++;
         } else if ( m_varnames[comp] == "F" ){
             m_all_field_functors[lev][comp] = std::make_unique<CellCenterFunctor>(warpx.getFieldPointer(FieldType::F_fp, lev), lev, m_crse_ratio);
@@ -690,7 +713,7 @@ FullDiagnostics::InitializeFieldFunctors (int lev)
         } else if ( m_varnames[comp] == "phi" ){
             m_all_field_functors[lev][comp] = std::make_unique<CellCenterFunctor>(warpx.getFieldPointer(FieldType::phi_fp, lev), lev, m_crse_ratio);
         } else if ( m_varnames[comp] == "part_per_cell" ){
-            m_all_field_functors[lev][comp] = std::make_unique<PartPerCellFunctor>(nullptr, lev, m_crse_ratio);
+            m_all_field_functors[lev][comp] = std::make_unique<PartPerCellFunctor>(nullptr, lev, m_crse_ratio, &m_deposition_planner);
         } else if ( m_varnames[comp] == "part_per_grid" ){
             m_all_field_functors[lev][comp] = std::make_unique<PartPerGridFunctor>(nullptr, lev, m_crse_ratio);
         } else if ( m_varnames[comp] == "divB" ){
@@ -762,7 +785,7 @@ FullDiagnostics::InitializeFieldFunctors (int lev)
         for (int ispec=0; ispec<int(m_pfield_species.size()); ispec++) {
             m_all_field_functors[lev][nvar + pcomp * nspec + ispec] = std::make_unique<ParticleReductionFunctor>(nullptr,
                     lev, m_crse_ratio, m_pfield_strings[pcomp], m_pfield_species_index[ispec], m_pfield_do_average[pcomp],
-                    m_pfield_dofilter[pcomp], m_pfield_filter_strings[pcomp]);
+                    m_pfield_dofilter[pcomp], m_pfield_filter_strings[pcomp], &m_deposition_planner);
         }
     }
     AddRZModesToDiags( lev );
@@ -780,6 +803,9 @@ FullDiagnostics::PrepareFieldDataForOutput ()
     warpx.UpdateAuxilaryData();
     warpx.FillBoundaryAux(warpx.getngUpdateAux());
 
+    // Deposit all the particle moments needed by the functors, in one pass over the particles
+    m_deposition_planner.Deposit(nlev_output);
+
     // Update the RealBox used for the geometry filter in particle diags
     // Note that full diagnostics every diag has only one buffer. (m_num_buffers = 1).
     // For m_geom_output[i_buffer][lev], the first element is the buffer index, and
@@ -50,6 +50,14 @@ MultiDiagnostics::InitializeFieldFunctors ( int lev )
     }
 }
 
+void
+MultiDiagnostics::Regrid ()
+{
+    for( auto& diag : alldiags ){
+        diag->Regrid();
+    }
+}
+
 void
 MultiDiagnostics::ReadParameters ()
 {
@@ -8,11 +8,10 @@
 #include "FieldMaximum.H"
 
 #include "FieldSolver/Fields.H"
+#include "SharedFieldReductions.H"
 #include "Utils/TextMsg.H"
 #include "WarpX.H"
 
-#include <ablastr/coarsen/sample.H>
-
 #include <AMReX_Algorithm.H>
 #include <AMReX_Array.H>
 #include <AMReX_Array4.H>
@@ -115,13 +114,8 @@ void FieldMaximum::ComputeDiags (int step)
     // loop over refinement levels
     for (int lev = 0; lev < nLevel; ++lev)
     {
-        // get MultiFab data at lev
-        const MultiFab & Ex = warpx.getField(FieldType::Efield_aux, lev,0);
-        const MultiFab & Ey = warpx.getField(FieldType::Efield_aux, lev,1);
-        const MultiFab & Ez = warpx.getField(FieldType::Efield_aux, lev,2);
-        const MultiFab & Bx = warpx.getField(FieldType::Bfield_aux, lev,0);
-        const MultiFab & By = warpx.getField(FieldType::Bfield_aux, lev,1);
-        const MultiFab & Bz = warpx.getField(FieldType::Bfield_aux, lev,2);
+        // get the maxima of the fields, computed by MultiReducedDiags
+        const auto& res = m_shared_field_reductions->Get(lev);
 
         constexpr int noutputs = 8; // max of Ex,Ey,Ez,|E|,Bx,By,Bz and |B|
         constexpr int index_Ex = 0;
@@ -133,94 +127,14 @@ void FieldMaximum::ComputeDiags (int step)
         constexpr int index_Bz = 6;
         constexpr int index_absB = 7;
 
-        // General preparation of interpolation and reduction operations
-        const GpuArray<int,3> cellCenteredtype{0,0,0};
-        const GpuArray<int,3> reduction_coarsening_ratio{1,1,1};
-        constexpr int reduction_comp = 0;
-
-        ReduceOps<ReduceOpMax,ReduceOpMax,ReduceOpMax,ReduceOpMax,
-                  ReduceOpMax,ReduceOpMax,ReduceOpMax,ReduceOpMax> reduce_op;
-        ReduceData<Real,Real,Real,Real,
-                   Real,Real,Real,Real> reduce_data(reduce_op);
-        using ReduceTuple = typename decltype(reduce_data)::Type;
-
-        // Prepare interpolation of field components to cell center
-        // The arrays below store the index type (staggering) of each MultiFab, with the third
-        // component set to zero in the two-dimensional case.
-        auto Extype = amrex::GpuArray<int,3>{0,0,0};
-        auto Eytype = amrex::GpuArray<int,3>{0,0,0};
-        auto Eztype = amrex::GpuArray<int,3>{0,0,0};
-        auto Bxtype = amrex::GpuArray<int,3>{0,0,0};
-        auto Bytype = amrex::GpuArray<int,3>{0,0,0};
-        auto Bztype = amrex::GpuArray<int,3>{0,0,0};
-        for (int i = 0; i < AMREX_SPACEDIM; ++i){
-            Extype[i] = Ex.ixType()[i];
-            Eytype[i] = Ey.ixType()[i];
-            Eztype[i] = Ez.ixType()[i];
-            Bxtype[i] = Bx.ixType()[i];
-            Bytype[i] = By.ixType()[i];
-            Bztype[i] = Bz.ixType()[i];
-        }
-
-        // MFIter loop to interpolate fields to cell center and get maximum values
-#ifdef AMREX_USE_OMP
-#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
-#endif
-        for ( MFIter mfi(Ex, TilingIfNotGPU()); mfi.isValid(); ++mfi )
-        {
-            // Make the box cell centered in preparation for the interpolation (and to avoid
-            // including ghost cells in the calculation)
-            const Box& box = enclosedCells(mfi.nodaltilebox());
-            const auto& arrEx = Ex[mfi].array();
-            const auto& arrEy = Ey[mfi].array();
-            const auto& arrEz = Ez[mfi].array();
-            const auto& arrBx = Bx[mfi].array();
-            const auto& arrBy = By[mfi].array();
-            const auto& arrBz = Bz[mfi].array();
-
-            reduce_op.eval(box, reduce_data,
-            [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
-            {
-                const Real Ex_interp = ablastr::coarsen::sample::Interp(arrEx, Extype, cellCenteredtype,
-                                                                        reduction_coarsening_ratio, i, j, k, reduction_comp);
-                const Real Ey_interp = ablastr::coarsen::sample::Interp(arrEy, Eytype, cellCenteredtype,
-                                                                        reduction_coarsening_ratio, i, j, k, reduction_comp);
-                const Real Ez_interp = ablastr::coarsen::sample::Interp(arrEz, Eztype, cellCenteredtype,
-                                                                        reduction_coarsening_ratio, i, j, k, reduction_comp);
-                const Real Bx_interp = ablastr::coarsen::sample::Interp(arrBx, Bxtype, cellCenteredtype,
-                                                                        reduction_coarsening_ratio, i, j, k, reduction_comp);
-                const Real By_interp = ablastr::coarsen::sample::Interp(arrBy, Bytype, cellCenteredtype,
-                                                                        reduction_coarsening_ratio, i, j, k, reduction_comp);
-                const Real Bz_interp = ablastr::coarsen::sample::Interp(arrBz, Bztype, cellCenteredtype,
-                                                                        reduction_coarsening_ratio, i, j, k, reduction_comp);
-                return {amrex::Math::abs(Ex_interp),
-                        amrex::Math::abs(Ey_interp),
-                        amrex::Math::abs(Ez_interp),
-                        amrex::Math::abs(Bx_interp),
-                        amrex::Math::abs(By_interp),
-                        amrex::Math::abs(Bz_interp),
-                        amrex::Math::powi<2>(Ex_interp) +
-                        amrex::Math::powi<2>(Ey_interp) +
-                        amrex::Math::powi<2>(Ez_interp),
-                        amrex::Math::powi<2>(Bx_interp) +
-                        amrex::Math::powi<2>(By_interp) +
-                        amrex::Math::powi<2>(Bz_interp)};
-            });
-        }
-
-        auto hv = reduce_data.value();
-        Real hv_Ex = amrex::get<0>(hv); // highest value of |Ex|
-        Real hv_Ey = amrex::get<1>(hv); // highest value of |Ey|
-        Real hv_Ez = amrex::get<2>(hv); // highest value of |Ez|
-        Real hv_Bx = amrex::get<3>(hv); // highest value of |Bx|
-        Real hv_By = amrex::get<4>(hv); // highest value of |By|
-        Real hv_Bz = amrex::get<5>(hv); // highest value of |Bz|
-        Real hv_E  = amrex::get<6>(hv); // highest value of |E|**2
-        Real hv_B  = amrex::get<7>(hv); // highest value of |B|**2
-
-        // MPI reduce
-        ParallelDescriptor::ReduceRealMax({hv_Ex,hv_Ey,hv_Ez,
-                                           hv_Bx,hv_By,hv_Bz, hv_E, hv_B});
+        Real hv_Ex = res.max_abs[0]; // highest value of |Ex|
+        Real hv_Ey = res.max_abs[1]; // highest value of |Ey|
+        Real hv_Ez = res.max_abs[2]; // highest value of |Ez|
+        Real hv_Bx = res.max_abs[3]; // highest value of |Bx|
+        Real hv_By = res.max_abs[4]; // highest value of |By|
+        Real hv_Bz = res.max_abs[5]; // highest value of |Bz|
+        Real hv_E  = res.max_E2; // highest value of |E|**2
+        Real hv_B  = res.max_B2; // highest value of |B|**2
 
         // Fill output array
         m_data[lev*noutputs+index_Ex] = hv_Ex;
@@ -8,12 +8,11 @@
 #include "FieldMomentum.H"
 
 #include "FieldSolver/Fields.H"
+#include "SharedFieldReductions.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXConst.H"
 #include "WarpX.H"
 
-#include <ablastr/coarsen/sample.H>
-
 #include <AMReX_Array.H>
 #include <AMReX_Array4.H>
 #include <AMReX_Box.H>
@@ -107,81 +106,11 @@ void FieldMomentum::ComputeDiags (int step)
     // Loop over refinement levels
     for (int lev = 0; lev < nLevel; ++lev)
     {
-        // Get MultiFab data at given refinement level
-        const amrex::MultiFab & Ex = warpx.getField(FieldType::Efield_aux, lev, 0);
-        const amrex::MultiFab & Ey = warpx.getField(FieldType::Efield_aux, lev, 1);
-        const amrex::MultiFab & Ez = warpx.getField(FieldType::Efield_aux, lev, 2);
-        const amrex::MultiFab & Bx = warpx.getField(FieldType::Bfield_aux, lev, 0);
-        const amrex::MultiFab & By = warpx.getField(FieldType::Bfield_aux, lev, 1);
-        const amrex::MultiFab & Bz = warpx.getField(FieldType::Bfield_aux, lev, 2);
-
-        // Cell-centered index type
-        const amrex::GpuArray<int,3> cc{0,0,0};
-        // Coarsening ratio (no coarsening)
-        const amrex::GpuArray<int,3> cr{1,1,1};
-        // Reduction component (fourth component in Array4)
-        constexpr int comp = 0;
-
-        // Index type (staggering) of each MultiFab
-        // (with third component set to zero in 2D)
-        amrex::GpuArray<int,3> Ex_stag{0,0,0};
-        amrex::GpuArray<int,3> Ey_stag{0,0,0};
-        amrex::GpuArray<int,3> Ez_stag{0,0,0};
-        amrex::GpuArray<int,3> Bx_stag{0,0,0};
-        amrex::GpuArray<int,3> By_stag{0,0,0};
-        amrex::GpuArray<int,3> Bz_stag{0,0,0};
-        for (int i = 0; i < AMREX_SPACEDIM; ++i)
-        {
-            Ex_stag[i] = Ex.ixType()[i];
-            Ey_stag[i] = Ey.ixType()[i];
-            Ez_stag[i] = Ez.ixType()[i];
-            Bx_stag[i] = Bx.ixType()[i];
-            By_stag[i] = By.ixType()[i];
-            Bz_stag[i] = Bz.ixType()[i];
-        }
-
-        amrex::ReduceOps<ReduceOpSum, ReduceOpSum, ReduceOpSum> reduce_ops;
-        amrex::ReduceData<Real, Real, Real> reduce_data(reduce_ops);
-
-#ifdef AMREX_USE_OMP
-#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
-#endif
-        // Loop over boxes, interpolate E,B data to cell centers
-        // and compute sum over cells of (E x B) components
-        for (amrex::MFIter mfi(Ex, TilingIfNotGPU()); mfi.isValid(); ++mfi)
-        {
-            const amrex::Box & box = enclosedCells(mfi.nodaltilebox());
-            const amrex::Array4<const amrex::Real> & Ex_arr = Ex[mfi].array();
-            const amrex::Array4<const amrex::Real> & Ey_arr = Ey[mfi].array();
-            const amrex::Array4<const amrex::Real> & Ez_arr = Ez[mfi].array();
-            const amrex::Array4<const amrex::Real> & Bx_arr = Bx[mfi].array();
-            const amrex::Array4<const amrex::Real> & By_arr = By[mfi].array();
-            const amrex::Array4<const amrex::Real> & Bz_arr = Bz[mfi].array();
-
-            // Compute E x B
-            reduce_ops.eval(box, reduce_data,
-                [=] AMREX_GPU_DEVICE (int i, int j, int k) -> amrex::GpuTuple<Real, Real, Real>
-                {
-                    const amrex::Real Ex_cc = ablastr::coarsen::sample::Interp(Ex_arr, Ex_stag, cc, cr, i, j, k, comp);
-                    const amrex::Real Ey_cc = ablastr::coarsen::sample::Interp(Ey_arr, Ey_stag, cc, cr, i, j, k, comp);
-                    const amrex::Real Ez_cc = ablastr::coarsen::sample::Interp(Ez_arr, Ez_stag, cc, cr, i, j, k, comp);
-
-                    const amrex::Real Bx_cc = ablastr::coarsen::sample::Interp(Bx_arr, Bx_stag, cc, cr, i, j, k, comp);
-                    const amrex::Real By_cc = ablastr::coarsen::sample::Interp(By_arr, By_stag, cc, cr, i, j, k, comp);
-                    const amrex::Real Bz_cc = ablastr::coarsen::sample::Interp(Bz_arr, Bz_stag, cc, cr, i, j, k, comp);
-
-                    return {Ey_cc * Bz_cc - Ez_cc * By_cc,
-                            Ez_cc * Bx_cc - Ex_cc * Bz_cc,
-                            Ex_cc * By_cc - Ey_cc * Bx_cc};
-                });
-        }
-
-        // MPI reduce
-        auto r = reduce_data.value();
-        amrex::Real ExB_x = amrex::get<0>(r);
-        amrex::Real ExB_y = amrex::get<1>(r);
-        amrex::Real ExB_z = amrex::get<2>(r);
-        amrex::ParallelDescriptor::ReduceRealSum({ExB_x,ExB_y,ExB_z});
+        // Get the sums of E x B over the cells, computed by MultiReducedDiags
+        const auto& sum_ExB = m_shared_field_reductions->Get(lev).sum_ExB;
+        const amrex::Real ExB_x = sum_ExB[0];
+        const amrex::Real ExB_y = sum_ExB[1];
+        const amrex::Real ExB_z = sum_ExB[2];
 
         // Get cell volume
         const std::array<Real, 3> &dx = WarpX::CellSize(lev);
@@ -0,0 +1,302 @@
+/* This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "MemoryUsage.H"
+
+#include "BoundaryConditions/PML.H"
+#include "Diagnostics/Diagnostics.H"
+#include "Diagnostics/MultiDiagnostics.H"
+#include "Diagnostics/ReducedDiags/ReducedDiags.H"
+#include "FieldSolver/Fields.H"
+#ifdef WARPX_USE_FFT
+#   include "FieldSolver/SpectralSolver/SpectralSolver.H"
+#endif
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/ParticleBoundaryBuffer.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/MemoryUtils.H"
+#include "Utils/WarpXAlgorithmSelection.H"
+#include "WarpX.H"
+
+#include <AMReX_Arena.H>
+#include <AMReX_CArena.H>
+#include <AMReX_INT.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_REAL.H>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace amrex::literals;
+using namespace warpx::fields;
+
+namespace
+{
+    // Names of the field types, in the order of the enum FieldType
+    const std::array<std::string,23> field_type_names{
+        "Efield_aux", "Bfield_aux", "Efield_fp", "Bfield_fp", "current_fp", "current_fp_nodal",
+        "rho_fp", "F_fp", "G_fp", "phi_fp", "vector_potential_fp",
+        "Efield_cp", "Bfield_cp", "current_cp", "rho_cp", "F_cp", "G_cp",
+        "edge_lengths", "face_areas",
+        "Efield_avg_fp", "Bfield_avg_fp", "Efield_avg_cp", "Bfield_avg_cp"};
+
+    // Names of the arenas, and the arenas
+    const std::array<std::string,4> arena_names{"arena", "device_arena", "managed_arena", "pinned_arena"};
+
+    std::array<amrex::Arena*,4> get_arenas ()
+    {
+        return {amrex::The_Arena(), amrex::The_Device_Arena(),
+                amrex::The_Managed_Arena(), amrex::The_Pinned_Arena()};
+    }
+
+    /** Whether the field type has three components, stored in three MultiFabs */
+    bool is_vector_field (FieldType const field_type)
+    {
+        return !(field_type == FieldType::rho_fp || field_type == FieldType::F_fp ||
+                 field_type == FieldType::G_fp || field_type == FieldType::phi_fp ||
+                 field_type == FieldType::rho_cp || field_type == FieldType::F_cp ||
+                 field_type == FieldType::G_cp);
+    }
+
+    /** Whether the storage of the field type is allocated (the vectors of MultiFabs of
+     *  some field types are only resized when they are used) */
+    bool is_field_allocated (WarpX const& warpx, FieldType const field_type)
+    {
+        switch (field_type) {
+            case FieldType::current_fp_nodal:
+                return warpx.do_current_centering;
+            case FieldType::vector_potential_fp:
+                return WarpX::electrostatic_solver_id == ElectrostaticSolverAlgo::LabFrameElectroMagnetostatic;
+            case FieldType::Efield_avg_fp:
+            case FieldType::Bfield_avg_fp:
+            case FieldType::Efield_avg_cp:
+            case FieldType::Bfield_avg_cp:
+                return WarpX::fft_do_time_averaging;
+            default:
+                return true;
+        }
+    }
+
+    /** Number of bytes allocated on this rank for the field type, on all the levels */
+    amrex::Long field_bytes (WarpX const& warpx, FieldType const field_type)
+    {
+        if (!is_field_allocated(warpx, field_type)) { return 0; }
+        const int ndir = is_vector_field(field_type) ? 3 : 1;
+        amrex::Long nbytes = 0;
+        for (int lev = 0; lev <= warpx.finestLevel(); ++lev) {
+            for (int dir = 0; dir < ndir; ++dir) {
+                if (warpx.isFieldInitialized(field_type, lev, dir)) {
+                    nbytes += warpx::memory::LocalBytes(warpx.getFieldPointer(field_type, lev, dir));
+                }
+            }
+        }
+        return nbytes;
+    }
+
+    /** Number of bytes allocated on this rank for the PML fields, on all the levels */
+    amrex::Long pml_bytes ([[maybe_unused]] WarpX& warpx)
+    {
+        amrex::Long nbytes = 0;
+#ifndef WARPX_DIM_RZ
+        for (int lev = 0; lev <= warpx.finestLevel(); ++lev) {
+            PML* const pml = warpx.GetPML(lev);
+            if (pml == nullptr) { continue; }
+            for (auto const& fields : {pml->GetE_fp(), pml->GetB_fp(), pml->Getj_fp(),
+                                       pml->GetE_cp(), pml->GetB_cp(), pml->Getj_cp()}) {
+                for (auto const* mf : fields) { nbytes += warpx::memory::LocalBytes(mf); }
+            }
+            for (auto const* mf : {pml->GetF_fp(), pml->GetF_cp(), pml->GetG_fp(), pml->GetG_cp()}) {
+                nbytes += warpx::memory::LocalBytes(mf);
+            }
+        }
+#endif
+        return nbytes;
+    }
+
+    /** Number of bytes allocated on this rank for the spectral data of the PSATD solver */
+    amrex::Long spectral_bytes ([[maybe_unused]] WarpX& warpx)
+    {
+        amrex::Long nbytes = 0;
+#if defined(WARPX_USE_FFT) && !defined(WARPX_DIM_RZ)
+        if (WarpX::electromagnetic_solver_id == ElectromagneticSolverAlgo::PSATD) {
+            for (int lev = 0; lev <= warpx.finestLevel(); ++lev) {
+                nbytes += warpx.get_spectral_solver_fp(lev).LocalBytes();
+            }
+        }
+#endif
+        return nbytes;
+    }
+}
+
+// constructor
+MemoryUsage::MemoryUsage (const std::string& rd_name)
+: ReducedDiags{rd_name}
+{
+    auto & warpx = WarpX::GetInstance();
+    const auto & mypc = warpx.GetPartContainer();
+    const auto species_names = mypc.GetSpeciesNames();
+    const int nSpecies = mypc.nSpecies();
+    auto & multi_diags = warpx.GetMultiDiags();
+    const int nDiags = multi_diags.GetTotalDiags();
+
+    // fields (by type, total, PML and spectral), particles (used and capacity of each
+    // species), boundary buffers, diagnostics buffers, arenas (used and reserved),
+    // total, and the maximum total and high-water mark over the ranks (and its rank)
+    const auto nfields = static_cast<int>(field_type_names.size());
+    const auto narenas = static_cast<int>(arena_names.size());
+    m_data.resize(nfields + 3 + 2*nSpecies + 1 + nDiags + 2*narenas + 4, 0.0_rt);
+
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        if ( m_write_header )
+        {
+            // open file
+            std::ofstream ofs{m_path + m_rd_name + "." + m_extension, std::ofstream::out};
+            // write header row
+            int c = 0;
+            ofs << "#";
+            ofs << "[" << c++ << "]step()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]time(s)";
+            for (auto const& name : field_type_names) {
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" << name << "(B)";
+            }
+            ofs << m_sep;
+            ofs << "[" << c++ << "]fields_total(B)";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]pml(B)";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]spectral(B)";
+            for (int i = 0; i < nSpecies; ++i) {
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" << species_names[i] << "_used(B)";
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" << species_names[i] << "_capacity(B)";
+            }
+            ofs << m_sep;
+            ofs << "[" << c++ << "]boundary_buffers(B)";
+            for (int i = 0; i < nDiags; ++i) {
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" << multi_diags.GetDiag(i).getDiagName() << "_buffers(B)";
+            }
+            for (auto const& name : arena_names) {
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" << name << "_used(B)";
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" << name << "_reserved(B)";
+            }
+            ofs << m_sep;
+            ofs << "[" << c++ << "]total(B)";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]max_rank_total(B)";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]max_rank_hwm(B)";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]max_rank_hwm_rank()";
+            ofs << std::endl;
+            // close file
+            ofs.close();
+        }
+    }
+}
+// end constructor
+
+// function that computes the memory usage
+void MemoryUsage::ComputeDiags (int step)
+{
+    // Judge if the diags should be done
+    if (!m_intervals.contains(step+1)) { return; }
+
+    auto & warpx = WarpX::GetInstance();
+    const auto & mypc = warpx.GetPartContainer();
+    const int nSpecies = mypc.nSpecies();
+    auto & multi_diags = warpx.GetMultiDiags();
+    const int nDiags = multi_diags.GetTotalDiags();
+
+    // Number of bytes on this rank, in the order of the columns (without the last four)
+    std::vector<amrex::Long> bytes;
+    bytes.reserve(m_data.size());
+
+    // fields
+    amrex::Long fields_total = 0;
+    for (int i = 0; i < static_cast<int>(field_type_names.size()); ++i) {
+        const amrex::Long nbytes = field_bytes(warpx, static_cast<FieldType>(i));
+        bytes.push_back(nbytes);
+        fields_total += nbytes;
+    }
+    const amrex::Long pml = pml_bytes(warpx);
+    const amrex::Long spectral = spectral_bytes(warpx);
+    bytes.push_back(fields_total + pml + spectral);
+    bytes.push_back(pml);
+    bytes.push_back(spectral);
+
+    // particles
+    amrex::Long particles_total = 0;
+    for (int i_s = 0; i_s < nSpecies; ++i_s) {
+        const auto [used, capacity] = warpx::memory::LocalParticleBytes(mypc.GetParticleContainer(i_s));
+        bytes.push_back(used);
+        bytes.push_back(capacity);
+        particles_total += capacity;
+    }
+
+    // particle boundary buffers
+    auto & boundary_buffer = warpx.GetParticleBoundaryBuffer();
+    amrex::Long boundary_total = 0;
+    for (int ib = 0; ib < ParticleBoundaryBuffer::numBoundaries(); ++ib) {
+        if (!boundary_buffer.isDefinedForAnySpecies(ib)) { continue; }
+        for (auto const& name : boundary_buffer.getSpeciesNames()) {
+            auto const* const pc = boundary_buffer.getParticleBufferPointer(name, ib);
+            boundary_total += warpx::memory::LocalParticleBytes(*pc).second;
+        }
+    }
+    bytes.push_back(boundary_total);
+
+    // diagnostics buffers
+    amrex::Long diags_total = 0;
+    for (int i = 0; i < nDiags; ++i) {
+        const amrex::Long nbytes = multi_diags.GetDiag(i).BufferBytes();
+        bytes.push_back(nbytes);
+        diags_total += nbytes;
+    }
+
+    // arenas (only the arenas of type CArena keep track of their memory)
+    for (auto* const arena : get_arenas()) {
+        auto const* const carena = dynamic_cast<amrex::CArena*>(arena);
+        bytes.push_back((carena != nullptr) ? static_cast<amrex::Long>(carena->heap_space_actually_used()) : 0);
+        bytes.push_back((carena != nullptr) ? static_cast<amrex::Long>(carena->heap_space_used()) : 0);
+    }
+
+    // total of the memory accounted for above (the arenas are not included,
+    // since they contain the memory of the fields and particles)
+    const amrex::Long total = fields_total + pml + spectral + particles_total + boundary_total + diags_total;
+    bytes.push_back(total);
+    m_hwm = std::max(m_hwm, total);
+
+    // sum over the ranks
+    const auto nsum = static_cast<int>(bytes.size());
+    amrex::ParallelDescriptor::ReduceLongSum(bytes.data(), nsum);
+
+    // maximum over the ranks of the total and of the high-water mark,
+    // and the (lowest) rank where the high-water mark is reached
+    std::array<amrex::Long,2> maxs{total, m_hwm};
+    amrex::ParallelDescriptor::ReduceLongMax(maxs.data(), static_cast<int>(maxs.size()));
+    const int nprocs = amrex::ParallelDescriptor::NProcs();
+    int hwm_rank = (m_hwm == maxs[1]) ? amrex::ParallelDescriptor::MyProc() : nprocs;
+    amrex::ParallelDescriptor::ReduceIntMin(hwm_rank);
+
+    for (int i = 0; i < nsum; ++i) {
+        m_data[i] = static_cast<amrex::Real>(bytes[i]);
+    }
+    m_data[nsum] = static_cast<amrex::Real>(maxs[0]);
+    m_data[nsum + 1] = static_cast<amrex::Real>(maxs[1]);
+    m_data[nsum + 2] = static_cast<amrex::Real>(hwm_rank);
+}
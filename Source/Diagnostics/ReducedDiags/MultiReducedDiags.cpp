@@ -16,6 +16,7 @@
 #include "FieldReduction.H"
 #include "LoadBalanceCosts.H"
 #include "LoadBalanceEfficiency.H"
+#include "MemoryUsage.H"
 #include "ParticleEnergy.H"
 #include "ParticleExtrema.H"
 #include "ParticleHistogram.H"
@@ -63,6 +64,7 @@ MultiReducedDiags::MultiReducedDiags ()
             {"ColliderRelevant",      [](CS s){return std::make_unique<ColliderRelevant>(s);}},
             {"LoadBalanceCosts",      [](CS s){return std::make_unique<LoadBalanceCosts>(s);}},
             {"LoadBalanceEfficiency", [](CS s){return std::make_unique<LoadBalanceEfficiency>(s);}},
+            {"MemoryUsage",           [](CS s){return std::make_unique<MemoryUsage>(s);}},
             {"ParticleHistogram",     [](CS s){return std::make_unique<ParticleHistogram>(s);}},
             {"ParticleHistogram2D",   [](CS s){return std::make_unique<ParticleHistogram2D>(s);}},
             {"ParticleNumber",        [](CS s){return std::make_unique<ParticleNumber>(s);}},
@@ -86,6 +88,10 @@ MultiReducedDiags::MultiReducedDiags ()
             return reduced_diags_dictionary.at(rd_type)(rd_name);
         });
     // end loop over all reduced diags
+
+    for (auto& rd : m_multi_rd) {
+        rd->m_shared_field_reductions = &m_shared_field_reductions;
+    }
 }
 // end constructor
 
@@ -111,6 +117,18 @@ void MultiReducedDiags::ComputeDiags (int step)
 {
     WARPX_PROFILE("MultiReducedDiags::ComputeDiags()");
 
+    // evaluate the field reductions of all the diags that are due in one pass
+    bool do_field_reductions = false;
+    bool do_field_energy = false;
+    for (const auto& rd : m_multi_rd)
+    {
+        if (rd->UsesSharedFieldReductions() && rd->m_intervals.contains(step+1)) {
+            do_field_reductions = true;
+            do_field_energy = do_field_energy || rd->UsesSharedFieldEnergy();
+        }
+    }
+    if (do_field_reductions) { m_shared_field_reductions.Compute(do_field_energy); }
+
     // loop over all reduced diags
     for (int i_rd = 0; i_rd < static_cast<int>(m_rd_names.size()); ++i_rd)
     {
@@ -0,0 +1,269 @@
+/* This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "SharedFieldReductions.H"
+
+#include "FieldSolver/Fields.H"
+#include "Utils/WarpXConst.H"
+#include "Utils/WarpXProfilerWrapper.H"
+#include "WarpX.H"
+
+#include <ablastr/coarsen/sample.H>
+
+#include <AMReX_Array.H>
+#include <AMReX_Array4.H>
+#include <AMReX_Box.H>
+#include <AMReX_Config.H>
+#include <AMReX_GpuControl.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_IntVect.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_Math.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Reduce.H>
+#include <AMReX_Tuple.H>
+
+#include <algorithm>
+
+using namespace amrex;
+using namespace warpx::fields;
+
+namespace
+{
+    constexpr int nfields = 6; // Ex, Ey, Ez, Bx, By, Bz
+    constexpr int nsums = nfields + 3; // squares of the fields and E x B
+    constexpr int nmaxs = nfields + 2; // absolute values of the fields, |E|^2 and |B|^2
+
+#if defined(WARPX_DIM_RZ)
+    /** Integral of the square of field over the volume of the local boxes, summed over
+     *  the modes and divided by the cell volume (same as the previous FieldEnergy::ComputeNorm2RZ,
+     *  without the MPI reduction) */
+    Real LocalNorm2RZ (const MultiFab& field, const int lev)
+    {
+        auto & warpx = WarpX::GetInstance();
+        const Real dr = warpx.Geom(lev).CellSize(0);
+
+        ReduceOps<ReduceOpSum> reduce_ops;
+        ReduceData<Real> reduce_data(reduce_ops);
+        using ReduceTuple = typename decltype(reduce_data)::Type;
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(field, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            Array4<const Real> const& field_arr = field.array(mfi);
+
+            const Box tilebox = mfi.tilebox();
+            Box tb = convert(tilebox, field.ixType().toIntVect());
+
+            // Lower corner of tile box physical domain
+            const XDim3 xyzmin = WarpX::LowerCorner(tilebox, lev, 0._rt);
+            const Dim3 lo = lbound(tilebox);
+            const Dim3 hi = ubound(tilebox);
+            const Real rmin = xyzmin.x + (tb.ixType().nodeCentered(0) ? 0._rt : 0.5_rt*dr);
+            const int irmin = lo.x;
+            const int irmax = hi.x;
+
+            int const ncomp = field.nComp();
+
+            for (int idir=0 ; idir < AMREX_SPACEDIM ; idir++) {
+                if (WarpX::field_boundary_hi[idir] == FieldBoundaryType::Periodic) {
+                    // For periodic boundaries, do not include the data in the nodes
+                    // on the upper edge of the domain
+                    tb.enclosedCells(idir);
+                }
+            }
+
+            reduce_ops.eval(tb, ncomp, reduce_data,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) -> ReduceTuple
+                {
+                    const Real r = rmin + (i - irmin)*dr;
+                    Real volume_factor = r;
+                    if (r == 0._rt) {
+                        volume_factor = dr/8._rt;
+                    } else if (rmin == 0._rt && i == irmax) {
+                        volume_factor = r/2._rt - dr/8._rt;
+                    }
+                    const Real theta_integral = (n == 0 ? 2._rt : 1._rt);
+                    return theta_integral*field_arr(i,j,k,n)*field_arr(i,j,k,n)*volume_factor;
+                });
+        }
+
+        return MathConst::pi*get<0>(reduce_data.value());
+    }
+#endif
+}
+
+void
+SharedFieldReductions::Compute (bool const do_energy)
+{
+    WARPX_PROFILE("SharedFieldReductions::Compute()");
+
+    auto & warpx = WarpX::GetInstance();
+    const int nLevel = warpx.finestLevel() + 1;
+
+    m_results.resize(nLevel);
+    m_overlap_masks.resize(nLevel);
+
+    for (int lev = 0; lev < nLevel; ++lev) {
+        ComputeLevel(lev, do_energy);
+    }
+
+    // Reduce the results of all the levels at once
+    Vector<Real> sums(nsums*nLevel);
+    Vector<Real> maxs(nmaxs*nLevel);
+    for (int lev = 0; lev < nLevel; ++lev) {
+        LevelResults const& res = m_results[lev];
+        std::copy(res.sum_squares.begin(), res.sum_squares.end(), sums.begin() + lev*nsums);
+        std::copy(res.sum_ExB.begin(), res.sum_ExB.end(), sums.begin() + lev*nsums + nfields);
+        std::copy(res.max_abs.begin(), res.max_abs.end(), maxs.begin() + lev*nmaxs);
+        maxs[lev*nmaxs + nfields] = res.max_E2;
+        maxs[lev*nmaxs + nfields + 1] = res.max_B2;
+    }
+
+    ParallelDescriptor::ReduceRealSum(sums.dataPtr(), static_cast<int>(sums.size()));
+    ParallelDescriptor::ReduceRealMax(maxs.dataPtr(), static_cast<int>(maxs.size()));
+
+    for (int lev = 0; lev < nLevel; ++lev) {
+        LevelResults& res = m_results[lev];
+        std::copy_n(sums.begin() + lev*nsums, nfields, res.sum_squares.begin());
+        std::copy_n(sums.begin() + lev*nsums + nfields, 3, res.sum_ExB.begin());
+        std::copy_n(maxs.begin() + lev*nmaxs, nfields, res.max_abs.begin());
+        res.max_E2 = maxs[lev*nmaxs + nfields];
+        res.max_B2 = maxs[lev*nmaxs + nfields + 1];
+    }
+}
+
+void
+SharedFieldReductions::ComputeLevel (int const lev, bool const do_energy)
+{
+    auto & warpx = WarpX::GetInstance();
+
+    const std::array<const MultiFab*,nfields> fields{
+        warpx.getFieldPointer(FieldType::Efield_aux, lev, 0),
+        warpx.getFieldPointer(FieldType::Efield_aux, lev, 1),
+        warpx.getFieldPointer(FieldType::Efield_aux, lev, 2),
+        warpx.getFieldPointer(FieldType::Bfield_aux, lev, 0),
+        warpx.getFieldPointer(FieldType::Bfield_aux, lev, 1),
+        warpx.getFieldPointer(FieldType::Bfield_aux, lev, 2)};
+
+#if !defined(WARPX_DIM_RZ)
+    // The overlap masks are only recomputed when the grids have changed
+    auto& masks = m_overlap_masks[lev];
+    if (do_energy) {
+        for (int ifield = 0; ifield < nfields; ++ifield) {
+            const MultiFab& field = *fields[ifield];
+            if (masks[ifield] == nullptr ||
+                masks[ifield]->boxArray() != field.boxArray() ||
+                masks[ifield]->DistributionMap() != field.DistributionMap()) {
+                masks[ifield] = field.OverlapMask(warpx.Geom(lev).periodicity());
+            }
+        }
+    }
+#endif
+
+    // Index type (staggering) of each field, with the third component set to zero in 2D
+    GpuArray<GpuArray<int,3>,nfields> stag{};
+    for (int ifield = 0; ifield < nfields; ++ifield) {
+        stag[ifield] = GpuArray<int,3>{0,0,0};
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            stag[ifield][idim] = fields[ifield]->ixType()[idim];
+        }
+    }
+    // Cell-centered index type and coarsening ratio (no coarsening) for the interpolation
+    const GpuArray<int,3> cc{0,0,0};
+    const GpuArray<int,3> cr{1,1,1};
+    constexpr int comp = 0;
+
+    ReduceOps<ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum,
+              ReduceOpMax, ReduceOpMax, ReduceOpMax, ReduceOpMax, ReduceOpMax, ReduceOpMax,
+              ReduceOpMax, ReduceOpMax,
+              ReduceOpSum, ReduceOpSum, ReduceOpSum> reduce_ops;
+    ReduceData<Real, Real, Real, Real, Real, Real,
+               Real, Real, Real, Real, Real, Real,
+               Real, Real,
+               Real, Real, Real> reduce_data(reduce_ops);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(*fields[0], TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        // The loop is done over the nodal tile box, which contains the points of all the
+        // staggerings. The maxima and E x B are evaluated on the cells of the tile,
+        // and the sums of the squares on the points of each field that belong to the tile.
+        const Box nodal_box = mfi.nodaltilebox();
+        const Box cc_box = enclosedCells(nodal_box);
+
+        GpuArray<Array4<const Real>,nfields> arr;
+        for (int ifield = 0; ifield < nfields; ++ifield) {
+            arr[ifield] = fields[ifield]->const_array(mfi);
+        }
+
+#if !defined(WARPX_DIM_RZ)
+        // In RZ, the sums of the squares are evaluated separately, see LocalNorm2RZ
+        const bool do_sum_squares = do_energy;
+        GpuArray<Box,nfields> boxes;
+        for (int ifield = 0; ifield < nfields; ++ifield) {
+            boxes[ifield] = mfi.tilebox(fields[ifield]->ixType().toIntVect());
+        }
+        GpuArray<Array4<const Real>,nfields> mask_arr;
+        if (do_energy) {
+            for (int ifield = 0; ifield < nfields; ++ifield) {
+                mask_arr[ifield] = masks[ifield]->const_array(mfi);
+            }
+        }
+#endif
+
+        reduce_ops.eval(nodal_box, reduce_data,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
+        {
+            const IntVect iv(AMREX_D_DECL(i,j,k));
+
+            GpuArray<Real,nfields> sq{0._rt, 0._rt, 0._rt, 0._rt, 0._rt, 0._rt};
+#if !defined(WARPX_DIM_RZ)
+            if (do_sum_squares) {
+                for (int ifield = 0; ifield < nfields; ++ifield) {
+                    if (!boxes[ifield].contains(iv)) { continue; }
+                    sq[ifield] = arr[ifield](i,j,k)*arr[ifield](i,j,k)/mask_arr[ifield](i,j,k);
+                }
+            }
+#endif
+
+            GpuArray<Real,nfields> f{0._rt, 0._rt, 0._rt, 0._rt, 0._rt, 0._rt};
+            if (cc_box.contains(iv)) {
+                for (int ifield = 0; ifield < nfields; ++ifield) {
+                    f[ifield] = ablastr::coarsen::sample::Interp(arr[ifield], stag[ifield], cc, cr, i, j, k, comp);
+                }
+            }
+
+            return {sq[0], sq[1], sq[2], sq[3], sq[4], sq[5],
+                    amrex::Math::abs(f[0]), amrex::Math::abs(f[1]), amrex::Math::abs(f[2]),
+                    amrex::Math::abs(f[3]), amrex::Math::abs(f[4]), amrex::Math::abs(f[5]),
+                    f[0]*f[0] + f[1]*f[1] + f[2]*f[2],
+                    f[3]*f[3] + f[4]*f[4] + f[5]*f[5],
+                    f[1]*f[5] - f[2]*f[4],
+                    f[2]*f[3] - f[0]*f[5],
+                    f[0]*f[4] - f[1]*f[3]};
+        });
+    }
+
+    auto const r = reduce_data.value();
+    LevelResults& res = m_results[lev];
+    res.sum_squares = {get<0>(r), get<1>(r), get<2>(r), get<3>(r), get<4>(r), get<5>(r)};
+#if defined(WARPX_DIM_RZ)
+    if (do_energy) {
+        for (int ifield = 0; ifield < nfields; ++ifield) {
+            res.sum_squares[ifield] = LocalNorm2RZ(*fields[ifield], lev);
+        }
+    }
+#endif
+    res.max_abs = {get<6>(r), get<7>(r), get<8>(r), get<9>(r), get<10>(r), get<11>(r)};
+    res.max_E2 = get<12>(r);
+    res.max_B2 = get<13>(r);
+    res.sum_ExB = {get<14>(r), get<15>(r), get<16>(r)};
+}
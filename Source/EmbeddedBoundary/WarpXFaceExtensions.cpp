@@ -14,6 +14,46 @@
 #include <AMReX_Scan.H>
 #include <AMReX_iMultiFab.H>
 #include <AMReX_MultiFab.H>
+#include <AMReX_Reduce.H>
+
+#include <map>
+#include <memory>
+#include <utility>
+
+namespace
+{
+    /**
+    * \brief Whether two FABs are defined on the same box and contain the same values
+    */
+    template <class FAB>
+    bool
+    SameData (const FAB& a, const FAB& b)
+    {
+        if (a.box() != b.box() || a.nComp() != b.nComp()) { return false; }
+
+        auto const& a_arr = a.const_array();
+        auto const& b_arr = b.const_array();
+        amrex::ReduceOps<amrex::ReduceOpMax> reduce_op;
+        amrex::ReduceData<int> reduce_data(reduce_op);
+        using ReduceTuple = typename decltype(reduce_data)::Type;
+        reduce_op.eval(a.box(), a.nComp(), reduce_data,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) -> ReduceTuple {
+                return {(a_arr(i, j, k, n) != b_arr(i, j, k, n)) ? 1 : 0};
+            });
+        return amrex::get<0>(reduce_data.value()) == 0;
+    }
+
+    /**
+    * \brief Make dst a copy of src
+    */
+    template <class FAB>
+    void
+    CopyFab (FAB& dst, const FAB& src)
+    {
+        dst.resize(src.box(), src.nComp());
+        dst.template copy<amrex::RunOn::Device>(src);
+    }
+}
 
 /**
 * \brief Get the value of arr in the neighbor (i_n, j_n) on the plane with normal 'dim'.
@@ -209,8 +249,14 @@ WarpX::ComputeFaceExtensions(){
             ablastr::warn_manager::WarnPriority::low
     );
 
-    InitBorrowing();
-    ComputeOneWayExtensions();
+    // The extensions of the boxes which are unchanged since the last call are restored here.
+    // Since they are complete, the counts of faces printed below after the one-way
+    // extensions already include the eight-ways extensions of these boxes.
+    std::array<amrex::LayoutData<FaceExtensionsStatus>, 3> status;
+    InitFaceExtensionsStatus(status);
+
+    InitBorrowing(status);
+    ComputeOneWayExtensions(status);
 
     amrex::Array1D<int, 0, 2> N_ext_faces_after_one_way = CountExtFaces();
     ablastr::warn_manager::WMRecordWarning("Embedded Boundary",
@@ -223,7 +269,7 @@ WarpX::ComputeFaceExtensions(){
             ablastr::warn_manager::WarnPriority::low
     );
 
-    ComputeEightWaysExtensions();
+    ComputeEightWaysExtensions(status);
     ShrinkBorrowing();
 
     amrex::Array1D<int, 0, 2> N_ext_faces_after_eight_ways = CountExtFaces();
@@ -242,19 +288,19 @@ WarpX::ComputeFaceExtensions(){
     // If any cell could not be extended we use the BCK method to stabilize them
 #if !defined(WARPX_DIM_XZ) && !defined(WARPX_DIM_RZ)
     if (N_ext_faces_after_eight_ways(0) > 0) {
-        ApplyBCKCorrection(0);
+        ApplyBCKCorrection(0, status);
         using_bck = true;
     }
 #endif
 
     if (N_ext_faces_after_eight_ways(1) > 0) {
-        ApplyBCKCorrection(1);
+        ApplyBCKCorrection(1, status);
         using_bck = true;
     }
 
 #if !defined(WARPX_DIM_XZ) && !defined(WARPX_DIM_RZ)
     if (N_ext_faces_after_eight_ways(2) > 0) {
-        ApplyBCKCorrection(2);
+        ApplyBCKCorrection(2, status);
         using_bck = true;
     }
 #endif
@@ -269,52 +315,165 @@ WarpX::ComputeFaceExtensions(){
                             ablastr::warn_manager::WarnPriority::low
         );
     }
+
+    StoreFaceExtensions(status);
 #endif
 }
 
 
 void
-WarpX::InitBorrowing() {
-    int idim = 0;
-    for (amrex::MFIter mfi(*Bfield_fp[maxLevel()][idim]); mfi.isValid(); ++mfi) {
-        amrex::Box const &box = mfi.validbox();
-        auto &borrowing_x = (*m_borrowing[maxLevel()][idim])[mfi];
-        borrowing_x.inds_pointer.resize(box);
-        borrowing_x.size.resize(box);
-        borrowing_x.size.setVal<amrex::RunOn::Device>(0);
-        const amrex::Long ncells = box.numPts();
-        // inds, neigh_faces and area are extended to their largest possible size here, but they are
-        // resized to a much smaller size later on, based on the actual number of neighboring
-        // intruded faces for each unstable face.
-        borrowing_x.inds.resize(8*ncells);
-        borrowing_x.neigh_faces.resize(8*ncells);
-        borrowing_x.area.resize(8*ncells);
-    }
-
-    idim = 1;
-    for (amrex::MFIter mfi(*Bfield_fp[maxLevel()][idim]); mfi.isValid(); ++mfi) {
-        amrex::Box const &box = mfi.validbox();
-        auto &borrowing_y = (*m_borrowing[maxLevel()][idim])[mfi];
-        borrowing_y.inds_pointer.resize(box);
-        borrowing_y.size.resize(box);
-        borrowing_y.size.setVal<amrex::RunOn::Device>(0);
-        const amrex::Long ncells = box.numPts();
-        borrowing_y.inds.resize(8*ncells);
-        borrowing_y.neigh_faces.resize(8*ncells);
-        borrowing_y.area.resize(8*ncells);
-    }
-
-    idim = 2;
-    for (amrex::MFIter mfi(*Bfield_fp[maxLevel()][idim]); mfi.isValid(); ++mfi) {
-        amrex::Box const &box = mfi.validbox();
-        auto &borrowing_z = (*m_borrowing[maxLevel()][idim])[mfi];
-        borrowing_z.inds_pointer.resize(box);
-        borrowing_z.size.resize(box);
-        borrowing_z.size.setVal<amrex::RunOn::Device>(0);
-        const amrex::Long ncells = box.numPts();
-        borrowing_z.inds.resize(8*ncells);
-        borrowing_z.neigh_faces.resize(8*ncells);
-        borrowing_z.area.resize(8*ncells);
+WarpX::InitFaceExtensionsStatus (std::array<amrex::LayoutData<FaceExtensionsStatus>, 3>& status)
+{
+    const int lev = maxLevel();
+    for (int idim = 0; idim < 3; ++idim) {
+        status[idim].define(boxArray(lev), DistributionMap(lev));
+    }
+
+    // Only the entries of the boxes which are still on this rank are kept
+    auto old_cache = std::move(m_face_extensions_cache);
+    m_face_extensions_cache.clear();
+
+    for (amrex::MFIter mfi(boxArray(lev), DistributionMap(lev)); mfi.isValid(); ++mfi) {
+
+        // The extensions are only needed in the directions in which some face of the box is unstable
+        bool has_ext_faces = false;
+        for (int idim = 0; idim < 3; ++idim) {
+            const amrex::Box box = amrex::convert(mfi.validbox(), m_flag_ext_face[lev][idim]->ixType());
+            auto const &flag_ext_face = m_flag_ext_face[lev][idim]->const_array(mfi);
+            amrex::ReduceOps<amrex::ReduceOpMax> reduce_op;
+            amrex::ReduceData<int> reduce_data(reduce_op);
+            using ReduceTuple = typename decltype(reduce_data)::Type;
+            reduce_op.eval(box, reduce_data,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple {
+                    return {flag_ext_face(i, j, k)};
+                });
+            const bool ext = amrex::get<0>(reduce_data.value()) > 0;
+            status[idim][mfi] = ext ? FaceExtensionsStatus::Computed : FaceExtensionsStatus::NoExtension;
+            has_ext_faces = has_ext_faces || ext;
+        }
+        if (!has_ext_faces) { continue; }
+
+        // The flags set in MarkCells only depend on the face areas and on the edge lengths,
+        // so the extensions can be reused if these are unchanged, including in the guard cells.
+        auto const it = old_cache.find(mfi.validbox());
+        bool cached = (it != old_cache.end());
+        for (int idim = 0; idim < 3 && cached; ++idim) {
+            cached = SameData(it->second->face_areas_in[idim], (*m_face_areas[lev][idim])[mfi])
+                && SameData(it->second->edge_lengths[idim], (*m_edge_lengths[lev][idim])[mfi]);
+        }
+
+        if (cached) {
+            const FaceExtensionsCacheEntry& entry = *it->second;
+            for (int idim = 0; idim < 3; ++idim) {
+                if (status[idim][mfi] == FaceExtensionsStatus::NoExtension) { continue; }
+                status[idim][mfi] = FaceExtensionsStatus::Cached;
+
+                (*m_face_areas[lev][idim])[mfi].copy<amrex::RunOn::Device>(entry.face_areas[idim]);
+                (*m_area_mod[lev][idim])[mfi].copy<amrex::RunOn::Device>(entry.area_mod[idim]);
+                (*m_flag_info_face[lev][idim])[mfi].copy<amrex::RunOn::Device>(entry.flag_info_face[idim]);
+                (*m_flag_ext_face[lev][idim])[mfi].copy<amrex::RunOn::Device>(entry.flag_ext_face[idim]);
+
+                auto &borrowing = (*m_borrowing[lev][idim])[mfi];
+                CopyFab(borrowing.size, entry.borrowing_size[idim]);
+                borrowing.neigh_faces = entry.neigh_faces[idim];
+                borrowing.area = entry.area[idim];
+                borrowing.inds = entry.inds[idim];
+                borrowing.vecs_size = entry.vecs_size[idim];
+
+                // The pointers are rebuilt from the offsets, since inds has been reallocated
+                const amrex::Box &box = entry.borrowing_offsets[idim].box();
+                borrowing.inds_pointer.resize(box);
+                auto const &borrowing_inds_pointer = borrowing.inds_pointer.array();
+                auto const &borrowing_offsets = entry.borrowing_offsets[idim].const_array();
+                int* borrowing_inds = borrowing.inds.data();
+                amrex::ParallelFor(box, [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+                    const int offset = borrowing_offsets(i, j, k);
+                    borrowing_inds_pointer(i, j, k) = (offset < 0) ? nullptr : borrowing_inds + offset;
+                });
+            }
+            m_face_extensions_cache[mfi.validbox()] = std::move(it->second);
+        } else {
+            // The inputs are saved now, since the BCK correction modifies the face areas
+            auto entry = std::make_unique<FaceExtensionsCacheEntry>();
+            for (int idim = 0; idim < 3; ++idim) {
+                CopyFab(entry->face_areas_in[idim], (*m_face_areas[lev][idim])[mfi]);
+                CopyFab(entry->edge_lengths[idim], (*m_edge_lengths[lev][idim])[mfi]);
+            }
+            m_face_extensions_cache[mfi.validbox()] = std::move(entry);
+        }
+    }
+}
+
+
+void
+WarpX::StoreFaceExtensions (const std::array<amrex::LayoutData<FaceExtensionsStatus>, 3>& status)
+{
+    const int lev = maxLevel();
+    for (amrex::MFIter mfi(boxArray(lev), DistributionMap(lev)); mfi.isValid(); ++mfi) {
+        auto const it = m_face_extensions_cache.find(mfi.validbox());
+        if (it == m_face_extensions_cache.end()) { continue; }
+        FaceExtensionsCacheEntry& entry = *it->second;
+
+        for (int idim = 0; idim < 3; ++idim) {
+            if (status[idim][mfi] != FaceExtensionsStatus::Computed) { continue; }
+
+            CopyFab(entry.face_areas[idim], (*m_face_areas[lev][idim])[mfi]);
+            CopyFab(entry.area_mod[idim], (*m_area_mod[lev][idim])[mfi]);
+            CopyFab(entry.flag_info_face[idim], (*m_flag_info_face[lev][idim])[mfi]);
+            CopyFab(entry.flag_ext_face[idim], (*m_flag_ext_face[lev][idim])[mfi]);
+
+            auto const &borrowing = (*m_borrowing[lev][idim])[mfi];
+            CopyFab(entry.borrowing_size[idim], borrowing.size);
+            entry.neigh_faces[idim] = borrowing.neigh_faces;
+            entry.area[idim] = borrowing.area;
+            entry.inds[idim] = borrowing.inds;
+            entry.vecs_size[idim] = borrowing.vecs_size;
+
+            const amrex::Box &box = borrowing.inds_pointer.box();
+            entry.borrowing_offsets[idim].resize(box);
+            auto const &borrowing_offsets = entry.borrowing_offsets[idim].array();
+            auto const &borrowing_inds_pointer = borrowing.inds_pointer.const_array();
+            int const* borrowing_inds = borrowing.inds.data();
+            amrex::ParallelFor(box, [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+                int const* p = borrowing_inds_pointer(i, j, k);
+                borrowing_offsets(i, j, k) = (p == nullptr) ? -1 : static_cast<int>(p - borrowing_inds);
+            });
+        }
+    }
+}
+
+
+void
+WarpX::InitBorrowing (const std::array<amrex::LayoutData<FaceExtensionsStatus>, 3>& status) {
+    for (int idim = 0; idim < 3; ++idim) {
+        for (amrex::MFIter mfi(*Bfield_fp[maxLevel()][idim]); mfi.isValid(); ++mfi) {
+            // The FaceInfoBoxes of the restored boxes are already set
+            if (status[idim][mfi] == FaceExtensionsStatus::Cached) { continue; }
+
+            amrex::Box const &box = mfi.validbox();
+            auto &borrowing = (*m_borrowing[maxLevel()][idim])[mfi];
+            borrowing.inds_pointer.resize(box);
+            borrowing.size.resize(box);
+            borrowing.size.setVal<amrex::RunOn::Device>(0);
+
+            if (status[idim][mfi] == FaceExtensionsStatus::NoExtension) {
+                // No face borrows area: the extensions are not computed for this box
+                borrowing.inds_pointer.setVal<amrex::RunOn::Device>(nullptr);
+                borrowing.inds.clear();
+                borrowing.neigh_faces.clear();
+                borrowing.area.clear();
+                borrowing.vecs_size = 0;
+                continue;
+            }
+
+            const amrex::Long ncells = box.numPts();
+            // inds, neigh_faces and area are extended to their largest possible size here, but they are
+            // resized to a much smaller size later on, based on the actual number of neighboring
+            // intruded faces for each unstable face.
+            borrowing.inds.resize(8*ncells);
+            borrowing.neigh_faces.resize(8*ncells);
+            borrowing.area.resize(8*ncells);
+        }
     }
 }
 
@@ -421,9 +580,8 @@ ComputeNBorrowEightFacesExtension(const amrex::Dim3 cell, const amrex::Real S_ex
 
 
 void
-WarpX::ComputeOneWayExtensions() {
-#ifdef AMREX_USE_EB
-#ifndef WARPX_DIM_RZ
+WarpX::ComputeOneWayExtensions (const std::array<amrex::LayoutData<FaceExtensionsStatus>, 3>& status) {
+#if defined(AMREX_USE_EB) and !defined(WARPX_DIM_RZ)
     auto const eb_fact = fieldEBFactory(maxLevel());
 
     auto const &cell_size = CellSize(maxLevel());
@@ -441,9 +599,16 @@ WarpX::ComputeOneWayExtensions() {
 #else
         WARPX_ABORT_WITH_MESSAGE(
             "ComputeOneWayExtensions: Only implemented in 2D3V and 3D3V");
+#endif
+        // Each box only modifies its own data (including the guard cells),
+        // so the boxes are processed concurrently on CPU
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
         for (amrex::MFIter mfi(*Bfield_fp[maxLevel()][idim]); mfi.isValid(); ++mfi) {
 
+            if (status[idim][mfi] != FaceExtensionsStatus::Computed) { continue; }
+
             amrex::Box const &box = mfi.validbox();
 
             auto const &S = m_face_areas[maxLevel()][idim]->array(mfi);
@@ -539,15 +704,15 @@ WarpX::ComputeOneWayExtensions() {
         }
     }
 
-#endif
+#else
+    amrex::ignore_unused(status);
 #endif
 }
 
 
 void
-WarpX::ComputeEightWaysExtensions() {
-#ifdef AMREX_USE_EB
-#ifndef WARPX_DIM_RZ
+WarpX::ComputeEightWaysExtensions (const std::array<amrex::LayoutData<FaceExtensionsStatus>, 3>& status) {
+#if defined(AMREX_USE_EB) and !defined(WARPX_DIM_RZ)
     auto const &cell_size = CellSize(maxLevel());
 
     const amrex::Real dx = cell_size[0];
@@ -563,9 +728,16 @@ WarpX::ComputeEightWaysExtensions() {
 #else
         WARPX_ABORT_WITH_MESSAGE(
             "ComputeEightWaysExtensions: Only implemented in 2D3V and 3D3V");
+#endif
+        // Each box only modifies its own data (including the guard cells),
+        // so the boxes are processed concurrently on CPU
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
         for (amrex::MFIter mfi(*Bfield_fp[maxLevel()][idim]); mfi.isValid(); ++mfi) {
 
+            if (status[idim][mfi] != FaceExtensionsStatus::Computed) { continue; }
+
             amrex::Box const &box = mfi.validbox();
 
             auto const &S = m_face_areas[maxLevel()][idim]->array(mfi);
@@ -698,12 +870,14 @@ WarpX::ComputeEightWaysExtensions() {
             }, amrex::Scan::Type::exclusive);
         }
     }
-#endif
+#else
+    amrex::ignore_unused(status);
 #endif
 }
 
 void
-WarpX::ApplyBCKCorrection(const int idim) {
+WarpX::ApplyBCKCorrection (const int idim,
+                           const std::array<amrex::LayoutData<FaceExtensionsStatus>, 3>& status) {
 #if defined(AMREX_USE_EB) and !defined(WARPX_DIM_RZ)
     const std::array<amrex::Real,3> &cell_size = CellSize(maxLevel());
 
@@ -711,8 +885,14 @@ WarpX::ApplyBCKCorrection(const int idim) {
     const amrex::Real dy = cell_size[1];
     const amrex::Real dz = cell_size[2];
 
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
     for (amrex::MFIter mfi(*Bfield_fp[maxLevel()][idim], amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
 
+        // The correction is already applied to the restored boxes
+        if (status[idim][mfi] != FaceExtensionsStatus::Computed) { continue; }
+
         const amrex::Box &box = mfi.tilebox();
         const amrex::Array4<int> &flag_ext_face = m_flag_ext_face[maxLevel()][idim]->array(mfi);
         const amrex::Array4<int> &flag_info_face = m_flag_info_face[maxLevel()][idim]->array(mfi);
@@ -731,7 +911,7 @@ WarpX::ApplyBCKCorrection(const int idim) {
         });
     }
 #else
-    amrex::ignore_unused(idim);
+    amrex::ignore_unused(idim, status);
 #endif
 }
 
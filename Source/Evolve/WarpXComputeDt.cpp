@@ -13,18 +13,25 @@
 #else
 #   include "FieldSolver/FiniteDifferenceSolver/FiniteDifferenceAlgorithms/CylindricalYeeAlgorithm.H"
 #endif
+#include "FieldSolver/ImplicitSolvers/ImplicitSolver.H"
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/WarpXParticleContainer.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXConst.H"
+#include "Utils/WarpXProfilerWrapper.H"
 
 #include <AMReX.H>
 #include <AMReX_Geometry.H>
 #include <AMReX_IntVect.H>
+#include <AMReX_MultiFab.H>
 #include <AMReX_Print.H>
 #include <AMReX_REAL.H>
 #include <AMReX_Vector.H>
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <memory>
 
 /**
@@ -99,6 +106,86 @@ WarpX::ComputeDt ()
     }
 }
 
+void
+WarpX::UpdateAdaptiveDt ()
+{
+    WARPX_PROFILE("WarpX::UpdateAdaptiveDt()");
+
+    using namespace amrex::literals;
+
+    const amrex::Real dt_old = dt[0];
+    // The time step can at most grow by a factor m_dt_max_growth at each update
+    amrex::Real deltat = dt_old*m_dt_max_growth;
+    if (m_max_dt.has_value()) {
+        deltat = std::min(deltat, m_max_dt.value());
+    }
+
+    // The particles do not move by more than cfl times the smallest cell size
+    const amrex::Real* dx = geom[max_level].CellSize();
+    const amrex::Real dx_min = *std::min_element(dx, dx+AMREX_SPACEDIM);
+    amrex::ParticleReal max_v = 0._prt;
+    for (int ispecies = 0; ispecies < mypc->nSpecies(); ++ispecies) {
+        max_v = std::max(max_v, mypc->GetParticleContainer(ispecies).maxParticleVelocity());
+    }
+    if (max_v > 0._prt) {
+        deltat = std::min(deltat, cfl*dx_min/static_cast<amrex::Real>(max_v));
+    }
+
+    // The plasma frequency is resolved: dt*omega_p < m_dt_plasma_frequency_resolution,
+    // with omega_p^2 bounded by the sum over the species of q*max(rho)/(m*epsilon_0)
+    if (m_dt_plasma_frequency_resolution.has_value()) {
+        amrex::Real omega_p2 = 0._rt;
+        for (int ispecies = 0; ispecies < mypc->nSpecies(); ++ispecies) {
+            WarpXParticleContainer& pc = mypc->GetParticleContainer(ispecies);
+            const amrex::Real q = std::abs(pc.getCharge());
+            const amrex::Real m = pc.getMass();
+            if (q == 0._rt || m == 0._rt) { continue; }
+            amrex::Real max_rho = 0._rt;
+            for (int lev = 0; lev <= finest_level; ++lev) {
+                const std::unique_ptr<amrex::MultiFab> rho = pc.GetChargeDensity(lev);
+                max_rho = std::max(max_rho, rho->norm0());
+            }
+            omega_p2 += q*max_rho/(m*PhysConst::ep0);
+        }
+        if (omega_p2 > 0._rt) {
+            deltat = std::min(deltat, m_dt_plasma_frequency_resolution.value()/std::sqrt(omega_p2));
+        }
+    }
+
+    // The number of nonlinear iterations of the implicit solver stays close to the target:
+    // dt is scaled by the ratio of the target and the number of iterations of the last step
+    if (m_implicit_solver && m_dt_target_nonlinear_iterations > 0) {
+        const int num_iterations = m_implicit_solver->GetNumNonlinearIterations();
+        if (num_iterations > 0) {
+            deltat = std::min(deltat,
+                dt_old*static_cast<amrex::Real>(m_dt_target_nonlinear_iterations)/num_iterations);
+        }
+    }
+
+    if (deltat == dt_old) { return; }
+
+    for (int lev = 0; lev <= max_level; ++lev) {
+        dt[lev] = deltat;
+    }
+
+    // With the explicit scheme, the momenta are known at t^n - dt_old/2:
+    // they are pushed to t^n - dt/2, using the fields at t^n.
+    if (evolve_scheme == EvolveScheme::Explicit) {
+        for (int lev = 0; lev <= finest_level; ++lev) {
+            mypc->PushP(lev, 0.5_rt*(dt_old - deltat),
+                        *Efield_aux[lev][0],*Efield_aux[lev][1],*Efield_aux[lev][2],
+                        *Bfield_aux[lev][0],*Bfield_aux[lev][1],*Bfield_aux[lev][2]);
+        }
+    }
+
+    // The damping factors of the PML depend on dt
+    ComputePMLFactors();
+
+    if (verbose) {
+        amrex::Print() << "Time step updated: dt = " << deltat << " (previous dt = " << dt_old << ")\n";
+    }
+}
+
 void
 WarpX::PrintDtDxDyDz ()
 {
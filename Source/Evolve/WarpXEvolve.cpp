@@ -94,11 +94,18 @@ WarpX::Evolve (int numsteps)
 
         CheckLoadBalance(step);
 
+        CheckRegrid(step);
+
         if (evolve_scheme == EvolveScheme::Explicit)
         {
             ExplicitFillBoundaryEBUpdateAux();
         }
 
+        // Adaptive time step (this needs the auxiliary fields with the explicit scheme)
+        if (m_dt_update_interval.contains(step+1)) {
+            UpdateAdaptiveDt();
+        }
+
         // If needed, deposit the initial ion charge and current densities that
         // will be used to update the E-field in Ohm's law.
         if (step == step_begin &&
@@ -112,7 +119,7 @@ WarpX::Evolve (int numsteps)
         doFieldIonization();
 
         ExecutePythonCallback("beforecollisions");
-        mypc->doCollisions( cur_time, dt[0] );
+        mypc->doCollisions( cur_time, dt[0], step, m_dt_update_interval.isActivated() );
         ExecutePythonCallback("aftercollisions");
 
 #ifdef WARPX_QED
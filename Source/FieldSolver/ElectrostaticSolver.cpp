@@ -50,7 +50,9 @@
 #   include <AMReX_EBFabFactory.H>
 #endif
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <memory>
 #include <string>
 
@@ -77,6 +79,14 @@ WarpX::ComputeSpaceChargeField (bool const reset_fields)
         AddSpaceChargeFieldLabFrame();
     }
     else {
+        if (electrostatic_solver_id == ElectrostaticSolverAlgo::Relativistic &&
+            m_self_fields_group_beta_tolerance >= 0._rt) {
+            // One Poisson solve per group of species with similar velocities
+            // (this includes the field due to the boundary potentials)
+            AddGroupedSpaceChargeField();
+            return;
+        }
+
         // Loop over the species and add their space-charge contribution to E and B.
         // Note that the fields calculated here does not include the E field
         // due to simulation boundary potentials
@@ -151,6 +161,77 @@ WarpX::AddSpaceChargeField (WarpXParticleContainer& pc)
         return;
     }
 
+    // Get the particle beta vector
+    bool const local_average = false; // Average across all MPI ranks
+    std::array<ParticleReal, 3> beta_pr = pc.meanParticleVelocity(local_average);
+    std::array<Real, 3> beta;
+    for (int i=0 ; i < static_cast<int>(beta.size()) ; i++) {
+        beta[i] = beta_pr[i]/PhysConst::c; // Normalize
+    }
+
+    AddSpaceChargeField({&pc}, beta, false);
+}
+
+void
+WarpX::AddGroupedSpaceChargeField ()
+{
+    WARPX_PROFILE("WarpX::AddGroupedSpaceChargeField");
+
+    // Group of species that share one Poisson solve. The normalized velocity of a group
+    // is the mean velocity of its first species, and a species joins the first group whose
+    // velocity differs from its own by at most the tolerance, for each component.
+    struct SpeciesGroup
+    {
+        std::array<Real, 3> beta;
+        Vector<WarpXParticleContainer*> species;
+    };
+    Vector<SpeciesGroup> groups;
+
+    // The field due to the boundary potentials is solved with beta=0, in the first group
+    groups.push_back(SpeciesGroup{{0._rt, 0._rt, 0._rt}, {}});
+
+    for (int ispecies=0; ispecies<mypc->nSpecies(); ispecies++){
+        WarpXParticleContainer& species = mypc->GetParticleContainer(ispecies);
+        if (species.getCharge() == 0) { continue; }
+
+        bool const local_average = false; // Average across all MPI ranks
+        std::array<ParticleReal, 3> beta_pr = species.meanParticleVelocity(local_average);
+        std::array<Real, 3> beta;
+        for (int i=0 ; i < static_cast<int>(beta.size()) ; i++) {
+            beta[i] = beta_pr[i]/PhysConst::c; // Normalize
+        }
+
+        bool found_group = false;
+        for (auto& group : groups) {
+            bool close = true;
+            for (int i=0 ; i < static_cast<int>(beta.size()) ; i++) {
+                close = close && (std::abs(beta[i] - group.beta[i]) <= m_self_fields_group_beta_tolerance);
+            }
+            if (close) {
+                group.species.push_back(&species);
+                found_group = true;
+                break;
+            }
+        }
+        if (!found_group) {
+            groups.push_back(SpeciesGroup{beta, {&species}});
+        }
+    }
+
+    for (int igroup=0; igroup<static_cast<int>(groups.size()); igroup++) {
+        // The first group always contributes the field due to the boundary potentials
+        bool const add_boundary_field = (igroup == 0);
+        AddSpaceChargeField(groups[igroup].species, groups[igroup].beta, add_boundary_field);
+    }
+}
+
+void
+WarpX::AddSpaceChargeField (const amrex::Vector<WarpXParticleContainer*>& species,
+                            const std::array<amrex::Real, 3>& beta,
+                            bool const add_boundary_field)
+{
+    WARPX_PROFILE("WarpX::AddSpaceChargeField");
+
     // Store the boundary conditions for the field solver if they haven't been
     // stored yet
     if (!m_poisson_boundary_handler.bcs_set) {
@@ -185,15 +266,17 @@ WarpX::AddSpaceChargeField (WarpXParticleContainer& pc)
         }
     }
 
-    // Deposit particle charge density (source of Poisson solver)
+    // Deposit the charge density of all the species of the group (source of Poisson solver)
     // The options below are identical to those in MultiParticleContainer::DepositCharge
     bool const local = true;
     bool const reset = false;
     bool const apply_boundary_and_scale_volume = true;
     bool const interpolate_across_levels = false;
-    if ( !pc.do_not_deposit) {
-        pc.DepositCharge(rho, local, reset, apply_boundary_and_scale_volume,
+    for (auto* pc : species) {
+        if ( !pc->do_not_deposit) {
+            pc->DepositCharge(rho, local, reset, apply_boundary_and_scale_volume,
                               interpolate_across_levels);
+        }
     }
     for (int lev = 0; lev <= max_level; lev++) {
         if (lev > 0) {
@@ -204,18 +287,34 @@ WarpX::AddSpaceChargeField (WarpXParticleContainer& pc)
     }
     SyncRho(rho, rho_coarse, charge_buf); // Apply filter, perform MPI exchange, interpolate across levels
 
-    // Get the particle beta vector
-    bool const local_average = false; // Average across all MPI ranks
-    std::array<ParticleReal, 3> beta_pr = pc.meanParticleVelocity(local_average);
-    std::array<Real, 3> beta;
-    for (int i=0 ; i < static_cast<int>(beta.size()) ; i++) {
-        beta[i] = beta_pr[i]/PhysConst::c; // Normalize
+    // The boundary potentials are the boundary conditions of phi: by linearity,
+    // the solution includes the field due to the boundary potentials
+    if (add_boundary_field) {
+        setPhiBC(phi);
+    }
+
+    // Use the most stringent solver parameters of the species of the group
+    Real required_precision = self_fields_required_precision;
+    Real absolute_tolerance = self_fields_absolute_tolerance;
+    int max_iters = self_fields_max_iters;
+    int verbosity = self_fields_verbosity;
+    if (!species.empty()) {
+        required_precision = species[0]->self_fields_required_precision;
+        absolute_tolerance = species[0]->self_fields_absolute_tolerance;
+        max_iters = species[0]->self_fields_max_iters;
+        verbosity = species[0]->self_fields_verbosity;
+        for (auto* pc : species) {
+            required_precision = std::min(required_precision, pc->self_fields_required_precision);
+            absolute_tolerance = std::min(absolute_tolerance, pc->self_fields_absolute_tolerance);
+            max_iters = std::max(max_iters, pc->self_fields_max_iters);
+            verbosity = std::max(verbosity, pc->self_fields_verbosity);
+        }
     }
 
     // Compute the potential phi, by solving the Poisson equation
-    computePhi( rho, phi, beta, pc.self_fields_required_precision,
-                pc.self_fields_absolute_tolerance, pc.self_fields_max_iters,
-                pc.self_fields_verbosity );
+    computePhi( rho, phi, beta, required_precision,
+                absolute_tolerance, max_iters,
+                verbosity );
 
     // Compute the corresponding electric and magnetic field, from the potential phi
     computeE( Efield_fp, phi, beta );
@@ -12,8 +12,6 @@
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "WarpX.H"
 
-#include <ablastr/coarsen/sample.H>
-
 #include <AMReX.H>
 #include <AMReX_Array4.H>
 #include <AMReX_Config.H>
@@ -109,18 +107,11 @@ void FiniteDifferenceSolver::MacroscopicEvolveECartesian (
     amrex::ignore_unused(edge_lengths);
 #endif
 
-    amrex::MultiFab& sigma_mf = macroscopic_properties->getsigma_mf();
-    amrex::MultiFab& epsilon_mf = macroscopic_properties->getepsilon_mf();
     amrex::MultiFab& mu_mf = macroscopic_properties->getmu_mf();
 
-    // Index type required for calling ablastr::coarsen::sample::Interp to interpolate macroscopic
-    // properties from their respective staggering to the Ex, Ey, Ez locations
-    amrex::GpuArray<int, 3> const& sigma_stag = macroscopic_properties->sigma_IndexType;
-    amrex::GpuArray<int, 3> const& epsilon_stag = macroscopic_properties->epsilon_IndexType;
-    amrex::GpuArray<int, 3> const& macro_cr     = macroscopic_properties->macro_cr_ratio;
-    amrex::GpuArray<int, 3> const& Ex_stag = macroscopic_properties->Ex_IndexType;
-    amrex::GpuArray<int, 3> const& Ey_stag = macroscopic_properties->Ey_IndexType;
-    amrex::GpuArray<int, 3> const& Ez_stag = macroscopic_properties->Ez_IndexType;
+    // The coefficients of the update, which depend on sigma and epsilon interpolated
+    // at the Ex, Ey, Ez locations, are only recomputed when dt or the medium change
+    macroscopic_properties->UpdateCoefficients<T_MacroAlgo>(Efield, dt);
 
     // Loop through the grids, and over the tiles within each grid
 #ifdef AMREX_USE_OMP
@@ -146,9 +137,10 @@ void FiniteDifferenceSolver::MacroscopicEvolveECartesian (
 #endif
 
         // material prop //
-        amrex::Array4<amrex::Real> const& sigma_arr = sigma_mf.array(mfi);
-        amrex::Array4<amrex::Real> const& eps_arr = epsilon_mf.array(mfi);
         amrex::Array4<amrex::Real> const& mu_arr = mu_mf.array(mfi);
+        MacroscopicCoefficients const coefs_Ex = macroscopic_properties->getCoefficients(0, mfi);
+        MacroscopicCoefficients const coefs_Ey = macroscopic_properties->getCoefficients(1, mfi);
+        MacroscopicCoefficients const coefs_Ez = macroscopic_properties->getCoefficients(2, mfi);
 
         // Extract stencil coefficients
         Real const * const AMREX_RESTRICT coefs_x = m_stencil_coefs_x.dataPtr();
@@ -169,8 +161,6 @@ void FiniteDifferenceSolver::MacroscopicEvolveECartesian (
         Box const& tex  = mfi.tilebox(Efield[0]->ixType().toIntVect());
         Box const& tey  = mfi.tilebox(Efield[1]->ixType().toIntVect());
         Box const& tez  = mfi.tilebox(Efield[2]->ixType().toIntVect());
-        // starting component to interpolate macro properties to Ex, Ey, Ez locations
-        const int scomp = 0;
         // Loop over the cells and update the fields
         amrex::ParallelFor(tex, tey, tez,
             [=] AMREX_GPU_DEVICE (int i, int j, int k){
@@ -178,14 +168,9 @@ void FiniteDifferenceSolver::MacroscopicEvolveECartesian (
                 // Skip field push if this cell is fully covered by embedded boundaries
                 if (lx(i, j, k) <= 0) return;
 #endif
-                // Interpolate conductivity, sigma, to Ex position on the grid
-                amrex::Real const sigma_interp = ablastr::coarsen::sample::Interp(sigma_arr, sigma_stag,
-                                                                                  Ex_stag, macro_cr, i, j, k, scomp);
-                // Interpolated permittivity, epsilon, to Ex position on the grid
-                amrex::Real const epsilon_interp = ablastr::coarsen::sample::Interp(eps_arr, epsilon_stag,
-                                                                                    Ex_stag, macro_cr, i, j, k, scomp);
-                const amrex::Real alpha = T_MacroAlgo::alpha( sigma_interp, epsilon_interp, dt);
-                const amrex::Real beta = T_MacroAlgo::beta( sigma_interp, epsilon_interp, dt);
+                amrex::Real alpha = 0;
+                amrex::Real beta = 0;
+                coefs_Ex(i, j, k, alpha, beta);
                 Ex(i, j, k) = alpha * Ex(i, j, k)
                             + beta * ( - T_Algo::DownwardDz(Hy, coefs_z, n_coefs_z, i, j, k,0)
                                        + T_Algo::DownwardDy(Hz, coefs_y, n_coefs_y, i, j, k,0)
@@ -202,14 +187,9 @@ void FiniteDifferenceSolver::MacroscopicEvolveECartesian (
                 if (lx(i, j, k)<=0 || lx(i-1, j, k)<=0 || lz(i, j, k)<=0 || lz(i, j-1, k)<=0) return;
 #endif
 #endif
-                // Interpolate conductivity, sigma, to Ey position on the grid
-                amrex::Real const sigma_interp = ablastr::coarsen::sample::Interp(sigma_arr, sigma_stag,
-                                                                                  Ey_stag, macro_cr, i, j, k, scomp);
-                // Interpolated permittivity, epsilon, to Ey position on the grid
-                amrex::Real const epsilon_interp = ablastr::coarsen::sample::Interp(eps_arr, epsilon_stag,
-                                                                                    Ey_stag, macro_cr, i, j, k, scomp);
-                const amrex::Real alpha = T_MacroAlgo::alpha( sigma_interp, epsilon_interp, dt);
-                const amrex::Real beta = T_MacroAlgo::beta( sigma_interp, epsilon_interp, dt);
+                amrex::Real alpha = 0;
+                amrex::Real beta = 0;
+                coefs_Ey(i, j, k, alpha, beta);
 
                 Ey(i, j, k) = alpha * Ey(i, j, k)
                             + beta * ( - T_Algo::DownwardDx(Hz, coefs_x, n_coefs_x, i, j, k,0)
@@ -222,14 +202,9 @@ void FiniteDifferenceSolver::MacroscopicEvolveECartesian (
                 // Skip field push if this cell is fully covered by embedded boundaries
                 if (lz(i,j,k) <= 0) return;
 #endif
-                // Interpolate conductivity, sigma, to Ez position on the grid
-                amrex::Real const sigma_interp = ablastr::coarsen::sample::Interp(sigma_arr, sigma_stag,
-                                                                                  Ez_stag, macro_cr, i, j, k, scomp);
-                // Interpolated permittivity, epsilon, to Ez position on the grid
-                amrex::Real const epsilon_interp = ablastr::coarsen::sample::Interp(eps_arr, epsilon_stag,
-                                                                                    Ez_stag, macro_cr, i, j, k, scomp);
-                const amrex::Real alpha = T_MacroAlgo::alpha( sigma_interp, epsilon_interp, dt);
-                const amrex::Real beta = T_MacroAlgo::beta( sigma_interp, epsilon_interp, dt);
+                amrex::Real alpha = 0;
+                amrex::Real beta = 0;
+                coefs_Ez(i, j, k, alpha, beta);
 
                 Ez(i, j, k) = alpha * Ez(i, j, k)
                             + beta * ( - T_Algo::DownwardDy(Hx, coefs_y, n_coefs_y, i, j, k,0)
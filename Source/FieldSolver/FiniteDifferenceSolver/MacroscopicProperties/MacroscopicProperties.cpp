@@ -9,6 +9,7 @@
 #include <AMReX_Array4.H>
 #include <AMReX_Config.H>
 #include <AMReX_Geometry.H>
+#include <AMReX_GpuContainers.H>
 #include <AMReX_GpuLaunch.H>
 #include <AMReX_IndexType.H>
 #include <AMReX_MFIter.H>
@@ -19,8 +20,12 @@
 
 #include <AMReX_BaseFwd.H>
 
+#include <array>
+#include <cstddef>
+#include <map>
 #include <memory>
 #include <sstream>
+#include <utility>
 
 using namespace amrex;
 using namespace warpx::fields;
@@ -116,6 +121,13 @@ MacroscopicProperties::ReadParameters ()
             utils::parser::makeParser(m_str_mu_function,{"x","y","z"}));
     }
 
+    // The coefficients of the E update can be stored as an index in a table
+    // of their distinct values, for piecewise-constant media
+    pp_macroscopic.query("compress_coefficients", m_compress_coefficients);
+    utils::parser::queryWithParser(
+        pp_macroscopic, "max_compressed_coefficients", m_max_compressed_coefficients);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_max_compressed_coefficients > 0,
+        "macroscopic.max_compressed_coefficients must be positive");
 }
 
 void
@@ -130,6 +142,8 @@ MacroscopicProperties::AllocateLevelMFs (
     m_eps_mf = std::make_unique<amrex::MultiFab>(ba, dmap, 1, ng_EB_alloc);
     // mu is cell-centered MultiFab
     m_mu_mf = std::make_unique<amrex::MultiFab>(ba, dmap, 1, ng_EB_alloc);
+
+    m_coefs_valid = false;
 }
 
 void
@@ -139,6 +153,9 @@ MacroscopicProperties::InitData (
     const amrex::IntVect& Ey_stag,
     const amrex::IntVect& Ez_stag)
 {
+    // The coefficients of the E update are recomputed from the new properties
+    m_coefs_valid = false;
+
     // Initialize sigma
     if (m_sigma_s == "constant") {
 
@@ -245,3 +262,92 @@ MacroscopicProperties::InitializeMacroMultiFabUsingParser (
 
     }
 }
+
+void
+MacroscopicProperties::CompressCoefficients ()
+{
+    // Distinct (alpha, beta) pairs of this rank, and their index in the tables
+    std::map<std::pair<Real,Real>, int> pairs;
+    std::array<std::unique_ptr<amrex::iMultiFab>, 3> index_mf;
+    bool too_many_pairs = false;
+
+    for (int idim = 0; idim < 3 && !too_many_pairs; ++idim) {
+        index_mf[idim] = std::make_unique<amrex::iMultiFab>(
+            m_alpha_mf[idim]->boxArray(), m_alpha_mf[idim]->DistributionMap(), 1, 0);
+
+        // The pairs are found on the host, for each grid
+        for ( amrex::MFIter mfi(*m_alpha_mf[idim]); mfi.isValid(); ++mfi ) {
+            amrex::FArrayBox const& alpha_fab = (*m_alpha_mf[idim])[mfi];
+            amrex::FArrayBox const& beta_fab = (*m_beta_mf[idim])[mfi];
+            amrex::IArrayBox& index_fab = (*index_mf[idim])[mfi];
+            const auto npts = static_cast<std::size_t>(alpha_fab.box().numPts());
+
+            amrex::Gpu::PinnedVector<Real> h_alpha(npts);
+            amrex::Gpu::PinnedVector<Real> h_beta(npts);
+            amrex::Gpu::PinnedVector<int> h_index(npts);
+            amrex::Gpu::copyAsync(amrex::Gpu::deviceToHost,
+                alpha_fab.dataPtr(), alpha_fab.dataPtr() + npts, h_alpha.begin());
+            amrex::Gpu::copyAsync(amrex::Gpu::deviceToHost,
+                beta_fab.dataPtr(), beta_fab.dataPtr() + npts, h_beta.begin());
+            amrex::Gpu::streamSynchronize();
+
+            for (std::size_t n = 0; n < npts; ++n) {
+                const auto next_index = static_cast<int>(pairs.size());
+                h_index[n] = pairs.try_emplace({h_alpha[n], h_beta[n]}, next_index).first->second;
+            }
+            if (static_cast<int>(pairs.size()) > m_max_compressed_coefficients) {
+                too_many_pairs = true;
+                break;
+            }
+
+            amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice,
+                h_index.begin(), h_index.end(), index_fab.dataPtr());
+            amrex::Gpu::streamSynchronize();
+        }
+    }
+
+    if (too_many_pairs) {
+        std::stringstream warnMsg;
+        warnMsg << "The medium has more than " << m_max_compressed_coefficients
+                << " distinct values of the coefficients of the E update:"
+                << " they are not compressed (see macroscopic.max_compressed_coefficients).";
+        ablastr::warn_manager::WMRecordWarning("Macroscopic properties", warnMsg.str());
+        return;
+    }
+
+    amrex::Vector<Real> h_table_alpha(pairs.size());
+    amrex::Vector<Real> h_table_beta(pairs.size());
+    for (auto const& [coefs, index] : pairs) {
+        h_table_alpha[index] = coefs.first;
+        h_table_beta[index] = coefs.second;
+    }
+    m_table_alpha.resize(pairs.size());
+    m_table_beta.resize(pairs.size());
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice,
+        h_table_alpha.begin(), h_table_alpha.end(), m_table_alpha.begin());
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice,
+        h_table_beta.begin(), h_table_beta.end(), m_table_beta.begin());
+    amrex::Gpu::streamSynchronize();
+
+    for (int idim = 0; idim < 3; ++idim) {
+        m_coefs_index_mf[idim] = std::move(index_mf[idim]);
+        m_alpha_mf[idim].reset();
+        m_beta_mf[idim].reset();
+    }
+    m_coefs_compressed = true;
+}
+
+MacroscopicCoefficients
+MacroscopicProperties::getCoefficients (int const idim, amrex::MFIter const& mfi) const
+{
+    MacroscopicCoefficients coefs;
+    if (m_coefs_compressed) {
+        coefs.index = m_coefs_index_mf[idim]->const_array(mfi);
+        coefs.table_alpha = m_table_alpha.dataPtr();
+        coefs.table_beta = m_table_beta.dataPtr();
+    } else {
+        coefs.alpha = m_alpha_mf[idim]->const_array(mfi);
+        coefs.beta = m_beta_mf[idim]->const_array(mfi);
+    }
+    return coefs;
+}
@@ -68,6 +68,9 @@ void ThetaImplicitEM::PrintParameters () const
     amrex::Print() << "Time-bias parameter theta:  " << m_theta << std::endl;
     amrex::Print() << "max particle iterations:    " << m_max_particle_iterations << std::endl;
     amrex::Print() << "particle tolerance:         " << m_particle_tolerance << std::endl;
+    if (m_particle_suborbit_caching) {
+        amrex::Print() << "particle suborbit tolerance: " << m_particle_suborbit_tolerance << std::endl;
+    }
     if (m_nlsolver_type==NonlinearSolverType::Picard) {
         amrex::Print() << "Nonlinear solver type:      Picard" << std::endl;
     }
@@ -126,6 +126,7 @@ WarpX::SaveParticlesAtImplicitStepStart ( )
             {
 
             auto particle_comps = pc->getParticleComps();
+            auto particle_icomps = pc->getParticleiComps();
 
             for (WarpXParIter pti(*pc, lev); pti.isValid(); ++pti) {
 
@@ -147,6 +148,12 @@ WarpX::SaveParticlesAtImplicitStepStart ( )
                 amrex::ParticleReal* uy_n = pti.GetAttribs(particle_comps["uy_n"]).dataPtr();
                 amrex::ParticleReal* uz_n = pti.GetAttribs(particle_comps["uz_n"]).dataPtr();
 
+                // All particles are pushed again at the start of the step
+                int* suborbit_state = nullptr;
+                if (do_particle_suborbit_caching) {
+                    suborbit_state = pti.GetiAttribs(particle_icomps["suborbit_state"]).dataPtr();
+                }
+
                 const long np = pti.numParticles();
 
                 amrex::ParallelFor( np, [=] AMREX_GPU_DEVICE (long ip)
@@ -154,6 +161,8 @@ WarpX::SaveParticlesAtImplicitStepStart ( )
                     amrex::ParticleReal xp, yp, zp;
                     getPosition(ip, xp, yp, zp);
 
+                    if (suborbit_state) { suborbit_state[ip] = SuborbitState::Fresh; }
+
 #if (AMREX_SPACEDIM >= 2)
                     x_n[ip] = xp;
 #endif
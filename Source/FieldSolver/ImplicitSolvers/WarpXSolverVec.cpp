@@ -6,6 +6,14 @@
  */
 #include "FieldSolver/ImplicitSolvers/WarpXSolverVec.H"
 
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_ParReduce.H>
+#include <AMReX_ParallelReduce.H>
+#include <AMReX_Tuple.H>
+
+#include <algorithm>
+#include <cmath>
+
 void WarpXSolverVec::SetDotMask( const amrex::Vector<amrex::Geometry>&  a_Geom )
 {
     if (m_dot_mask_defined) { return; }
@@ -49,3 +57,158 @@ void WarpXSolverVec::SetDotMask( const amrex::Vector<amrex::Geometry>&  a_Geom )
     amrex::ParallelAllReduce::Sum(result, amrex::ParallelContext::CommunicatorSub());
     return result;
 }
+
+void WarpXSolverVec::linComb (const RT a, const WarpXSolverVec& X, const RT b, const WarpXSolverVec& Y,
+                              const RT c, const WarpXSolverVec& Z)
+{
+    for (int lev = 0; lev < m_num_amr_levels; ++lev) {
+        for (int n = 0; n < 3; ++n) {
+            auto const& wa = m_field_vec[lev][n]->arrays();
+            auto const& xa = X.getVec()[lev][n]->const_arrays();
+            auto const& ya = Y.getVec()[lev][n]->const_arrays();
+            auto const& za = Z.getVec()[lev][n]->const_arrays();
+            amrex::ParallelFor( *m_field_vec[lev][n],
+                [=] AMREX_GPU_DEVICE (int bno, int i, int j, int k)
+                {
+                    wa[bno](i,j,k) = a*xa[bno](i,j,k) + b*ya[bno](i,j,k) + c*za[bno](i,j,k);
+                });
+        }
+    }
+    amrex::Gpu::streamSynchronize();
+}
+
+amrex::Real WarpXSolverVec::linCombAndNorm2 (const RT a, const WarpXSolverVec& X,
+                                             const RT b, const WarpXSolverVec& Y,
+                                             const RT c, const WarpXSolverVec& Z)
+{
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        m_dot_mask_defined,
+        "WarpXSolverVec::linCombAndNorm2 called with m_dotMask not yet defined");
+    RT result = 0.0;
+    const int lev = 0;
+    for (int n = 0; n < 3; ++n) {
+        auto const& mask = m_dotMask[lev][n]->const_arrays();
+        auto const& wa = m_field_vec[lev][n]->arrays();
+        auto const& xa = X.getVec()[lev][n]->const_arrays();
+        auto const& ya = Y.getVec()[lev][n]->const_arrays();
+        auto const& za = Z.getVec()[lev][n]->const_arrays();
+        result += amrex::ParReduce(amrex::TypeList<amrex::ReduceOpSum>{},
+                                   amrex::TypeList<RT>{},
+                                   *m_field_vec[lev][n], amrex::IntVect::TheZeroVector(),
+            [=] AMREX_GPU_DEVICE (int bno, int i, int j, int k) -> amrex::GpuTuple<RT>
+            {
+                const RT w = a*xa[bno](i,j,k) + b*ya[bno](i,j,k) + c*za[bno](i,j,k);
+                wa[bno](i,j,k) = w;
+                return { mask[bno](i,j,k) ? w*w : RT(0.0) };
+            });
+    }
+    amrex::ParallelAllReduce::Sum(result, amrex::ParallelContext::CommunicatorSub());
+    return std::sqrt(result);
+}
+
+amrex::Real WarpXSolverVec::incrementAndNorm2 (const WarpXSolverVec& X, const RT a)
+{
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        m_dot_mask_defined,
+        "WarpXSolverVec::incrementAndNorm2 called with m_dotMask not yet defined");
+    RT result = 0.0;
+    const int lev = 0;
+    for (int n = 0; n < 3; ++n) {
+        auto const& mask = m_dotMask[lev][n]->const_arrays();
+        auto const& ya = m_field_vec[lev][n]->arrays();
+        auto const& xa = X.getVec()[lev][n]->const_arrays();
+        result += amrex::ParReduce(amrex::TypeList<amrex::ReduceOpSum>{},
+                                   amrex::TypeList<RT>{},
+                                   *m_field_vec[lev][n], amrex::IntVect::TheZeroVector(),
+            [=] AMREX_GPU_DEVICE (int bno, int i, int j, int k) -> amrex::GpuTuple<RT>
+            {
+                const RT y = ya[bno](i,j,k) + a*xa[bno](i,j,k);
+                ya[bno](i,j,k) = y;
+                return { mask[bno](i,j,k) ? y*y : RT(0.0) };
+            });
+    }
+    amrex::ParallelAllReduce::Sum(result, amrex::ParallelContext::CommunicatorSub());
+    return std::sqrt(result);
+}
+
+void WarpXSolverVec::dotProducts (const amrex::Vector<const WarpXSolverVec*>& a_X,
+                                  amrex::Vector<RT>& a_dots) const
+{
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        m_dot_mask_defined,
+        "WarpXSolverVec::dotProducts called with m_dotMask not yet defined");
+    const int nvec = static_cast<int>(a_X.size());
+    a_dots.assign(nvec, RT(0.0));
+    if (nvec == 0) { return; }
+
+    addLocalDotProducts(a_X, a_dots.data());
+    amrex::ParallelAllReduce::Sum(a_dots.data(), nvec, amrex::ParallelContext::CommunicatorSub());
+}
+
+void WarpXSolverVec::dotProducts (const WarpXSolverVec& a_Y,
+                                  const amrex::Vector<const WarpXSolverVec*>& a_X,
+                                  amrex::Vector<RT>& a_dots,
+                                  amrex::Vector<RT>& a_Ydots) const
+{
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        m_dot_mask_defined,
+        "WarpXSolverVec::dotProducts called with m_dotMask not yet defined");
+    const int nvec = static_cast<int>(a_X.size());
+    a_dots.assign(nvec, RT(0.0));
+    a_Ydots.assign(nvec, RT(0.0));
+    if (nvec == 0) { return; }
+
+    amrex::Vector<RT> dots(2*nvec, RT(0.0));
+    addLocalDotProducts(a_X, dots.data());
+    a_Y.addLocalDotProducts(a_X, dots.data() + nvec);
+    amrex::ParallelAllReduce::Sum(dots.data(), 2*nvec, amrex::ParallelContext::CommunicatorSub());
+    for (int j = 0; j < nvec; ++j) {
+        a_dots[j] = dots[j];
+        a_Ydots[j] = dots[nvec + j];
+    }
+}
+
+void WarpXSolverVec::addLocalDotProducts (const amrex::Vector<const WarpXSolverVec*>& a_X,
+                                          RT* a_dots) const
+{
+    const int nvec = static_cast<int>(a_X.size());
+
+    // The dot products are computed by chunks of (up to) four vectors,
+    // so that the data of this vector is read once per chunk
+    constexpr int nchunk = 4;
+    const int lev = 0;
+    for (int j0 = 0; j0 < nvec; j0 += nchunk) {
+        const int nj = std::min(nchunk, nvec - j0);
+        // Unused slots of the last chunk point to the first vector of the chunk
+        // and are not accumulated
+        const auto& X0 = *a_X[j0];
+        const auto& X1 = *a_X[j0 + std::min(1, nj-1)];
+        const auto& X2 = *a_X[j0 + std::min(2, nj-1)];
+        const auto& X3 = *a_X[j0 + std::min(3, nj-1)];
+        for (int n = 0; n < 3; ++n) {
+            auto const& mask = m_dotMask[lev][n]->const_arrays();
+            auto const& ya = m_field_vec[lev][n]->const_arrays();
+            auto const& x0 = X0.getVec()[lev][n]->const_arrays();
+            auto const& x1 = X1.getVec()[lev][n]->const_arrays();
+            auto const& x2 = X2.getVec()[lev][n]->const_arrays();
+            auto const& x3 = X3.getVec()[lev][n]->const_arrays();
+            auto const r = amrex::ParReduce(
+                amrex::TypeList<amrex::ReduceOpSum, amrex::ReduceOpSum,
+                                amrex::ReduceOpSum, amrex::ReduceOpSum>{},
+                amrex::TypeList<RT, RT, RT, RT>{},
+                *m_field_vec[lev][n], amrex::IntVect::TheZeroVector(),
+                [=] AMREX_GPU_DEVICE (int bno, int i, int j, int k) -> amrex::GpuTuple<RT, RT, RT, RT>
+                {
+                    const RT y = mask[bno](i,j,k) ? ya[bno](i,j,k) : RT(0.0);
+                    return { y*x0[bno](i,j,k),
+                             (nj > 1) ? y*x1[bno](i,j,k) : RT(0.0),
+                             (nj > 2) ? y*x2[bno](i,j,k) : RT(0.0),
+                             (nj > 3) ? y*x3[bno](i,j,k) : RT(0.0) };
+                });
+            a_dots[j0] += amrex::get<0>(r);
+            if (nj > 1) { a_dots[j0+1] += amrex::get<1>(r); }
+            if (nj > 2) { a_dots[j0+2] += amrex::get<2>(r); }
+            if (nj > 3) { a_dots[j0+3] += amrex::get<3>(r); }
+        }
+    }
+}
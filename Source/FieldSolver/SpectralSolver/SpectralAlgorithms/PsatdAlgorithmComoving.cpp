@@ -47,18 +47,15 @@ PsatdAlgorithmComoving::PsatdAlgorithmComoving (const SpectralKSpace& spectral_k
 {
     amrex::ignore_unused(update_with_rho);
 
-    const BoxArray& ba = spectral_kspace.spectralspace_ba;
-
-    // Allocate arrays of real spectral coefficients
-    C_coef    = SpectralRealCoefficients(ba, dm, 1, 0);
-    S_ck_coef = SpectralRealCoefficients(ba, dm, 1, 0);
-
-    // Allocate arrays of complex spectral coefficients
-    X1_coef     = SpectralComplexCoefficients(ba, dm, 1, 0);
-    X2_coef     = SpectralComplexCoefficients(ba, dm, 1, 0);
-    X3_coef     = SpectralComplexCoefficients(ba, dm, 1, 0);
-    X4_coef     = SpectralComplexCoefficients(ba, dm, 1, 0);
-    Theta2_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
+    // Allocate the real and complex spectral coefficients: they are shared by all the boxes
+    // with the same FFT size (on this MPI rank, and across the spectral solvers of all levels)
+    // and are only computed for the first of these boxes
+    const amrex::Vector<amrex::Real> params{
+        amrex::Real(norder_x), amrex::Real(norder_y), amrex::Real(norder_z), amrex::Real(grid_type),
+        v_comoving[0], v_comoving[1], v_comoving[2], dt};
+    m_shared_coefs.define(spectral_kspace, dm, "PsatdAlgorithmComoving", params,
+                          {&C_coef, &S_ck_coef},
+                          {&X1_coef, &X2_coef, &X3_coef, &X4_coef, &Theta2_coef});
 
     // Initialize real and complex spectral coefficients
     InitializeSpectralCoefficients(spectral_kspace, dm, dt);
@@ -162,9 +159,12 @@ void PsatdAlgorithmComoving::InitializeSpectralCoefficients (const SpectralKSpac
 {
     const amrex::BoxArray& ba = spectral_kspace.spectralspace_ba;
 
-    // Loop over boxes and allocate the corresponding coefficients for each box
+    // Loop over boxes and compute the coefficients of the boxes that do not share
+    // the coefficients of a box for which they have already been computed
     for (amrex::MFIter mfi(ba, dm); mfi.isValid(); ++mfi) {
 
+        if (!m_shared_coefs.needsInit(mfi)) { continue; }
+
         const amrex::Box& bx = ba[mfi];
 
         // Extract pointers for the k vectors
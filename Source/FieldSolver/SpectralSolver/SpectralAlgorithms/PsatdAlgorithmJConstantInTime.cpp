@@ -64,33 +64,38 @@ PsatdAlgorithmJConstantInTime::PsatdAlgorithmJConstantInTime(
     m_is_galilean{
         (v_galilean[0] != 0.) || (v_galilean[1] != 0.) || (v_galilean[2] != 0.)}
 {
-    const amrex::BoxArray& ba = spectral_kspace.spectralspace_ba;
-
     // Always allocate these coefficients
-    C_coef = SpectralRealCoefficients(ba, dm, 1, 0);
-    S_ck_coef = SpectralRealCoefficients(ba, dm, 1, 0);
-    X1_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
-    X2_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
-    X3_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
+    amrex::Vector<SharedSpectralCoefficients::RealCoefficients*> real_coefs{&C_coef, &S_ck_coef};
+    amrex::Vector<SharedSpectralCoefficients::ComplexCoefficients*> complex_coefs{&X1_coef, &X2_coef, &X3_coef};
 
     // Allocate these coefficients only with Galilean PSATD
     if (m_is_galilean)
     {
-        X4_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
-        T2_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
+        complex_coefs.insert(complex_coefs.end(), {&X4_coef, &T2_coef});
     }
 
+    // Allocate these coefficients only with time averaging
+    if (time_averaging)
+    {
+        complex_coefs.insert(complex_coefs.end(),
+            {&Psi1_coef, &Psi2_coef, &Y1_coef, &Y3_coef, &Y2_coef, &Y4_coef});
+    }
+
+    // The coefficients are shared by all the boxes with the same FFT size (on this
+    // MPI rank, and across the spectral solvers of all levels) and are only computed
+    // for the first of these boxes
+    const amrex::Vector<amrex::Real> params{
+        amrex::Real(norder_x), amrex::Real(norder_y), amrex::Real(norder_z), amrex::Real(grid_type),
+        v_galilean[0], v_galilean[1], v_galilean[2], dt,
+        amrex::Real(update_with_rho), amrex::Real(time_averaging),
+        amrex::Real(dive_cleaning), amrex::Real(divb_cleaning)};
+    m_shared_coefs.define(spectral_kspace, dm, "PsatdAlgorithmJConstantInTime", params,
+                          real_coefs, complex_coefs);
+
     InitializeSpectralCoefficients(spectral_kspace, dm, dt);
 
-    // Allocate these coefficients only with time averaging
     if (time_averaging)
     {
-        Psi1_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
-        Psi2_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
-        Y1_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
-        Y3_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
-        Y2_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
-        Y4_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
         InitializeSpectralCoefficientsAveraging(spectral_kspace, dm, dt);
     }
 
@@ -363,9 +368,12 @@ void PsatdAlgorithmJConstantInTime::InitializeSpectralCoefficients (
 
     const amrex::BoxArray& ba = spectral_kspace.spectralspace_ba;
 
-    // Loop over boxes and allocate the corresponding coefficients for each box
+    // Loop over boxes and compute the coefficients of the boxes that do not share
+    // the coefficients of a box for which they have already been computed
     for (amrex::MFIter mfi(ba, dm); mfi.isValid(); ++mfi)
     {
+        if (!m_shared_coefs.needsInit(mfi)) { continue; }
+
         const amrex::Box& bx = ba[mfi];
 
         // Extract pointers for the k vectors
@@ -524,9 +532,12 @@ void PsatdAlgorithmJConstantInTime::InitializeSpectralCoefficientsAveraging (
 {
     const amrex::BoxArray& ba = spectral_kspace.spectralspace_ba;
 
-    // Loop over boxes and allocate the corresponding coefficients for each box
+    // Loop over boxes and compute the coefficients of the boxes that do not share
+    // the coefficients of a box for which they have already been computed
     for (amrex::MFIter mfi(ba, dm); mfi.isValid(); ++mfi)
     {
+        if (!m_shared_coefs.needsInit(mfi)) { continue; }
+
         const amrex::Box& bx = ba[mfi];
 
         // Extract pointers for the k vectors
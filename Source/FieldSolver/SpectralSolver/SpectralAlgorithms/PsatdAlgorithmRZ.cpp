@@ -124,7 +124,7 @@ PsatdAlgorithmRZ::pushSpectralFields(SpectralFieldDataRZ & f)
         // Loop over indices within one box
         // Note that k = 0
         int const modes = f.n_rz_azimuthal_modes;
-        amrex::ParallelFor(bx, modes,
+        ParallelForModes(bx, modes, f.mode_parallel,
         [=] AMREX_GPU_DEVICE(int i, int j, int k, int mode) noexcept
         {
             const int idx_jx = (J_linear) ? static_cast<int>(Idx.Jx_old) : static_cast<int>(Idx.Jx_mid);
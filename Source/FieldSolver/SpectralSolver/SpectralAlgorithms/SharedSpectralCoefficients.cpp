@@ -0,0 +1,100 @@
+/* This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "SharedSpectralCoefficients.H"
+
+#include <AMReX_Box.H>
+#include <AMReX_BoxArray.H>
+#include <AMReX_FabArrayBase.H>
+#include <AMReX_RealVect.H>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+#if WARPX_USE_FFT
+
+using namespace amrex;
+
+bool
+SharedSpectralCoefficients::Key::operator< (const Key& other) const
+{
+    if (algorithm != other.algorithm) { return algorithm < other.algorithm; }
+    if (fft_size != other.fft_size) { return fft_size.lexLT(other.fft_size); }
+    return params < other.params;
+}
+
+std::map<SharedSpectralCoefficients::Key, std::weak_ptr<SharedSpectralCoefficients::Entry>>&
+SharedSpectralCoefficients::Cache ()
+{
+    static std::map<Key, std::weak_ptr<Entry>> cache;
+    return cache;
+}
+
+void
+SharedSpectralCoefficients::define (const SpectralKSpace& spectral_kspace,
+                                    const DistributionMapping& dm,
+                                    const std::string& algorithm,
+                                    const Vector<Real>& params,
+                                    const Vector<RealCoefficients*>& real_coefs,
+                                    const Vector<ComplexCoefficients*>& complex_coefs)
+{
+    const BoxArray& ba = spectral_kspace.spectralspace_ba;
+    auto& cache = Cache();
+
+    // Remove the entries that are no longer used by any algorithm
+    for (auto it = cache.begin(); it != cache.end();) {
+        if (it->second.expired()) { it = cache.erase(it); } else { ++it; }
+    }
+
+    // The coefficients are defined without allocation: their data is set below
+    for (auto* coef : real_coefs) { coef->define(ba, dm, 1, 0, MFInfo().SetAlloc(false)); }
+    for (auto* coef : complex_coefs) { coef->define(ba, dm, 1, 0, MFInfo().SetAlloc(false)); }
+
+    // The key includes the cell size, on which the k vectors depend
+    Vector<Real> key_params(params);
+    const RealVect dx = spectral_kspace.getCellSize();
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) { key_params.push_back(dx[idim]); }
+
+    m_entries.clear();
+    m_needs_init.define(ba, dm);
+
+    for (MFIter mfi(ba, dm); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = ba[mfi];
+        const Key key{algorithm, spectral_kspace.getFFTSize(mfi.index()), key_params};
+
+        std::shared_ptr<Entry> entry = cache[key].lock();
+        m_needs_init[mfi] = (entry == nullptr);
+        if (entry == nullptr) {
+            // First box with this shape and these parameters: allocate the coefficients,
+            // which are computed by the algorithm
+            entry = std::make_shared<Entry>();
+            for (std::size_t n = 0; n < real_coefs.size(); ++n) {
+                entry->real_coefs.push_back(std::make_unique<BaseFab<Real>>(bx, 1));
+            }
+            for (std::size_t n = 0; n < complex_coefs.size(); ++n) {
+                entry->complex_coefs.push_back(std::make_unique<BaseFab<Complex>>(bx, 1));
+            }
+            cache[key] = entry;
+        }
+
+        // Alias the data of the entry (all the boxes in spectral space start at 0,
+        // so that boxes with the same FFT size have identical boxes in spectral space)
+        for (std::size_t n = 0; n < real_coefs.size(); ++n) {
+            real_coefs[n]->setFab(mfi, std::make_unique<BaseFab<Real>>(
+                bx, 1, entry->real_coefs[n]->dataPtr()));
+        }
+        for (std::size_t n = 0; n < complex_coefs.size(); ++n) {
+            complex_coefs[n]->setFab(mfi, std::make_unique<BaseFab<Complex>>(
+                bx, 1, entry->complex_coefs[n]->dataPtr()));
+        }
+
+        if (std::find(m_entries.begin(), m_entries.end(), entry) == m_entries.end()) {
+            m_entries.push_back(std::move(entry));
+        }
+    }
+}
+
+#endif // WARPX_USE_FFT
@@ -7,6 +7,7 @@
  */
 #include "SpectralFieldData.H"
 
+#include "Utils/MemoryUtils.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXUtil.H"
 #include "WarpX.H"
@@ -209,6 +210,14 @@ SpectralFieldData::~SpectralFieldData()
     }
 }
 
+amrex::Long
+SpectralFieldData::LocalBytes () const
+{
+    return warpx::memory::LocalBytes(fields)
+        + warpx::memory::LocalBytes(tmpSpectralField)
+        + warpx::memory::LocalBytes(tmpRealField);
+}
+
 /* \brief Transform the component `i_comp` of MultiFab `mf`
  *  to spectral space, and store the corresponding result internally
  *  (in the spectral field specified by `field_index`) */
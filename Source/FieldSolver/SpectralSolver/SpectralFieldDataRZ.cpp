@@ -33,6 +33,9 @@ SpectralFieldDataRZ::SpectralFieldDataRZ (const int lev,
                                           int const n_modes)
     : n_rz_azimuthal_modes(n_modes),
       m_ncomps(2 * n_modes - 1),
+#if defined(AMREX_USE_OMP) && !defined(AMREX_USE_GPU)
+      mode_parallel(WarpX::fft_rz_mode_parallel && n_modes > 1),
+#endif
       m_n_fields(n_field_required)
 {
     amrex::BoxArray const & spectralspace_ba = k_space.spectralspace_ba;
@@ -152,12 +155,15 @@ SpectralFieldDataRZ::SpectralFieldDataRZ (const int lev,
         }
 #else
         // Create FFTW plans.
+        // When the modes are processed in parallel, the plans transform one single mode,
+        // and are executed on the data of each mode by a different thread.
+        // The data of a mode is then not necessarily aligned like the data of mode 0.
         fftw_iodim dims[1];
         fftw_iodim howmany_dims[2];
         dims[0].n = grid_size[1];
         dims[0].is = grid_size[0];
         dims[0].os = grid_size[0];
-        howmany_dims[0].n = n_rz_azimuthal_modes;
+        howmany_dims[0].n = (mode_parallel) ? 1 : n_rz_azimuthal_modes;
         howmany_dims[0].is = grid_size[0]*grid_size[1];
         howmany_dims[0].os = grid_size[0]*grid_size[1];
         howmany_dims[1].n = grid_size[0];
@@ -179,7 +185,7 @@ SpectralFieldDataRZ::SpectralFieldDataRZ (const int lev,
                                reinterpret_cast<
                                 ablastr::math::anyfft::Complex*>(tmpSpectralField[mfi].dataPtr()), // complex *out
                                FFTW_FORWARD, // int sign
-                               FFTW_ESTIMATE); // unsigned flags
+                               (mode_parallel) ? FFTW_ESTIMATE | FFTW_UNALIGNED : FFTW_ESTIMATE); // unsigned flags
         backward_plan[mfi] =
 #ifdef AMREX_USE_FLOAT
             fftwf_plan_guru_dft
@@ -195,12 +201,13 @@ SpectralFieldDataRZ::SpectralFieldDataRZ (const int lev,
                                reinterpret_cast<
                                 ablastr::math::anyfft::Complex*>(tempHTransformed[mfi].dataPtr()), // complex *out
                                FFTW_BACKWARD, // int sign
-                               FFTW_ESTIMATE); // unsigned flags
+                               (mode_parallel) ? FFTW_ESTIMATE | FFTW_UNALIGNED : FFTW_ESTIMATE); // unsigned flags
 #endif
 
         // Create the Hankel transformer for each box.
         amrex::XDim3 const xyzmax = WarpX::UpperCorner(mfi.tilebox(), lev, 0._rt);
-        multi_spectral_hankel_transformer[mfi] = SpectralHankelTransformer(grid_size[0], n_rz_azimuthal_modes, xyzmax.x);
+        multi_spectral_hankel_transformer[mfi] = SpectralHankelTransformer(
+            grid_size[0], n_rz_azimuthal_modes, xyzmax.x, mode_parallel);
     }
 }
 
@@ -304,11 +311,29 @@ SpectralFieldDataRZ::FABZForwardTransform (amrex::MFIter const & mfi, amrex::Box
     amrex::The_Arena()->free(buffer);
     result = rocfft_execution_info_destroy(execinfo);
 #else
+    if (mode_parallel) {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for
+#endif
+        for (int mode=0 ; mode < n_rz_azimuthal_modes ; mode++) {
 #  ifdef AMREX_USE_FLOAT
-    fftwf_execute(forward_plan[mfi]);
+            fftwf_execute_dft
 #  else
-    fftw_execute(forward_plan[mfi]);
+            fftw_execute_dft
 #  endif
+                            (forward_plan[mfi],
+                             reinterpret_cast<
+                              ablastr::math::anyfft::Complex*>(tempHTransformed[mfi].dataPtr(mode)), // complex *in
+                             reinterpret_cast<
+                              ablastr::math::anyfft::Complex*>(tmpSpectralField[mfi].dataPtr(mode))); // complex *out
+        }
+    } else {
+#  ifdef AMREX_USE_FLOAT
+        fftwf_execute(forward_plan[mfi]);
+#  else
+        fftw_execute(forward_plan[mfi]);
+#  endif
+    }
 #endif
 
     // Copy the spectral-space field `tmpSpectralField` to the appropriate
@@ -423,11 +448,29 @@ SpectralFieldDataRZ::FABZBackwardTransform (amrex::MFIter const & mfi, amrex::Bo
     amrex::The_Arena()->free(buffer);
     result = rocfft_execution_info_destroy(execinfo);
 #else
+    if (mode_parallel) {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for
+#endif
+        for (int mode=0 ; mode < n_rz_azimuthal_modes ; mode++) {
+#  ifdef AMREX_USE_FLOAT
+            fftwf_execute_dft
+#  else
+            fftw_execute_dft
+#  endif
+                            (backward_plan[mfi],
+                             reinterpret_cast<
+                              ablastr::math::anyfft::Complex*>(tmpSpectralField[mfi].dataPtr(mode)), // complex *in
+                             reinterpret_cast<
+                              ablastr::math::anyfft::Complex*>(tempHTransformed[mfi].dataPtr(mode))); // complex *out
+        }
+    } else {
 #  ifdef AMREX_USE_FLOAT
-    fftwf_execute(backward_plan[mfi]);
+        fftwf_execute(backward_plan[mfi]);
 #  else
-    fftw_execute(backward_plan[mfi]);
+        fftw_execute(backward_plan[mfi]);
 #  endif
+    }
 #endif
 
     // Copy the interleaved complex to the split complex.
@@ -8,12 +8,15 @@
 
 #include "Utils/WarpXConst.H"
 
+#include <AMReX_Config.H>
+
 #include <memory>
 
 SpectralHankelTransformer::SpectralHankelTransformer (int const nr,
                                                       int const n_rz_azimuthal_modes,
-                                                      amrex::Real const rmax)
-: m_nr(nr), m_n_rz_azimuthal_modes(n_rz_azimuthal_modes)
+                                                      amrex::Real const rmax,
+                                                      bool const mode_parallel)
+: m_nr(nr), m_n_rz_azimuthal_modes(n_rz_azimuthal_modes), m_mode_parallel(mode_parallel)
 {
 
     dht0.resize(m_n_rz_azimuthal_modes);
@@ -65,6 +68,9 @@ SpectralHankelTransformer::PhysicalToSpectral_Scalar (amrex::FArrayBox const & F
     // can be done.
     // Note that F_physical does not include the imaginary part of mode 0,
     // but G_spectral does.
+#if defined(AMREX_USE_OMP) && !defined(AMREX_USE_GPU)
+#pragma omp parallel for if (m_mode_parallel)
+#endif
     for (int mode=0 ; mode < m_n_rz_azimuthal_modes ; mode++) {
         int const mode_r = 2*mode;
         int const mode_i = 2*mode + 1;
@@ -96,6 +102,9 @@ SpectralHankelTransformer::PhysicalToSpectral_Vector (amrex::Box const & box,
     amrex::Array4<amrex::Real> const & F_r_physical_array = F_r_physical.array();
     amrex::Array4<amrex::Real> const & F_t_physical_array = F_t_physical.array();
 
+#if defined(AMREX_USE_OMP) && !defined(AMREX_USE_GPU)
+#pragma omp parallel for if (m_mode_parallel)
+#endif
     for (int mode=0 ; mode < m_n_rz_azimuthal_modes ; mode++) {
 
         int const mode_r = 2*mode;
@@ -140,6 +149,9 @@ SpectralHankelTransformer::SpectralToPhysical_Scalar (amrex::FArrayBox const & G
 
     amrex::Gpu::streamSynchronize();
 
+#if defined(AMREX_USE_OMP) && !defined(AMREX_USE_GPU)
+#pragma omp parallel for if (m_mode_parallel)
+#endif
     for (int mode=0 ; mode < m_n_rz_azimuthal_modes ; mode++) {
         int const mode_r = 2*mode;
         int const mode_i = 2*mode + 1;
@@ -167,6 +179,9 @@ SpectralHankelTransformer::SpectralToPhysical_Vector (amrex::Box const & box,
     amrex::Array4<amrex::Real> const & F_r_physical_array = F_r_physical.array();
     amrex::Array4<amrex::Real> const & F_t_physical_array = F_t_physical.array();
 
+#if defined(AMREX_USE_OMP) && !defined(AMREX_USE_GPU)
+#pragma omp parallel for if (m_mode_parallel)
+#endif
     for (int mode=0 ; mode < m_n_rz_azimuthal_modes ; mode++) {
 
         int const mode_r = 2*mode;
@@ -38,7 +38,8 @@ using namespace amrex;
 SpectralKSpace::SpectralKSpace( const BoxArray& realspace_ba,
                                 const DistributionMapping& dm,
                                 const RealVect realspace_dx )
-    : dx(realspace_dx)  // Store the cell size as member `dx`
+    : dx(realspace_dx),  // Store the cell size as member `dx`
+      m_realspace_ba(realspace_ba)
 {
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
         realspace_ba.ixType()==IndexType::TheCellType(),
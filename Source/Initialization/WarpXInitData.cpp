@@ -573,6 +573,11 @@ WarpX::InitFromScratch ()
         m_implicit_solver->Define(this);
         m_implicit_solver->GetParticleSolverParams( max_particle_its_in_implicit_scheme,
                                                     particle_tol_in_implicit_scheme );
+        m_implicit_solver->GetParticleSuborbitParams( do_particle_suborbit_caching,
+                                                      particle_suborbit_tol_in_implicit_scheme );
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            !do_particle_suborbit_caching || max_level == 0,
+            "implicit_evolve.particle_suborbit_caching is only implemented for max_level = 0");
 
         // Add space to save the positions and velocities at the start of the time steps
         for (auto const& pc : *mypc) {
@@ -586,6 +591,10 @@ WarpX::InitFromScratch ()
             pc->AddRealComp("ux_n");
             pc->AddRealComp("uy_n");
             pc->AddRealComp("uz_n");
+            if (do_particle_suborbit_caching) {
+                // Convergence state of each particle within the nonlinear iterations
+                pc->AddIntComp("suborbit_state");
+            }
         }
 
     }
@@ -610,7 +619,9 @@ WarpX::InitPML ()
             do_pml_Hi[0][idim] = 1; // on level 0
         }
     }
-    if (finest_level > 0) { do_pml = 1; }
+    // PML are also added around the refinement patches, including those that may
+    // only be created later on when regridding
+    if (finest_level > 0 || (regrid_int > 0 && maxLevel() > 0)) { do_pml = 1; }
     if (do_pml)
     {
 #if (defined WARPX_DIM_RZ) && (defined WARPX_USE_FFT)
@@ -633,45 +644,63 @@ WarpX::InitPML ()
             do_pml_Lo[0], do_pml_Hi[0]);
 #endif
 
-        for (int lev = 1; lev <= finest_level; ++lev)
-        {
-            do_pml_Lo[lev] = amrex::IntVect::TheUnitVector();
-            do_pml_Hi[lev] = amrex::IntVect::TheUnitVector();
-            // check if fine patch edges co-incide with domain boundary
-            const amrex::Box levelBox = boxArray(lev).minimalBox();
-            // Domain box at level, lev
-            const amrex::Box DomainBox = Geom(lev).Domain();
-            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
-                if (levelBox.smallEnd(idim) == DomainBox.smallEnd(idim)) {
-                    do_pml_Lo[lev][idim] = do_pml_Lo[0][idim];
-                }
-                if (levelBox.bigEnd(idim) == DomainBox.bigEnd(idim)) {
-                    do_pml_Hi[lev][idim] = do_pml_Hi[0][idim];
-                }
-            }
+        InitPMLOnFineLevels();
+    }
+}
 
-#ifdef WARPX_DIM_RZ
-            //In cylindrical geometry, if the edge of the patch is at r=0, do not add PML
-            if ((max_level > 0) && (fine_tag_lo[0]==0.)) {
-                do_pml_Lo[lev][0] = 0;
-            }
-#endif
-            // Note: fill_guards_fields and fill_guards_current are both set to
-            // zero (amrex::IntVect(0)) (what we do with damping BCs does not apply
-            // to the PML, for example in the presence of mesh refinement patches)
-            pml[lev] = std::make_unique<PML>(
-                lev, boxArray(lev), DistributionMap(lev), do_similar_dm_pml,
-                &Geom(lev), &Geom(lev-1),
-                pml_ncell, pml_delta, refRatio(lev-1),
-                dt[lev], nox_fft, noy_fft, noz_fft, grid_type,
-                do_moving_window, pml_has_particles, do_pml_in_domain,
-                psatd_solution_type, J_in_time, rho_in_time, do_pml_dive_cleaning, do_pml_divb_cleaning,
-                amrex::IntVect(0), amrex::IntVect(0),
-                guard_cells.ng_FieldSolver.max(),
-                v_particle_pml,
-                do_pml_Lo[lev], do_pml_Hi[lev]);
+void
+WarpX::InitPMLOnFineLevels ()
+{
+    if (!do_pml) { return; }
+
+    for (int lev = 1; lev <= finest_level; ++lev) {
+        InitPMLOnFineLevel(lev);
+    }
+
+    // Remove the PML of the levels that no longer exist
+    for (int lev = finest_level+1; lev <= maxLevel(); ++lev) {
+        pml[lev].reset();
+    }
+}
+
+void
+WarpX::InitPMLOnFineLevel (int lev)
+{
+    do_pml_Lo[lev] = amrex::IntVect::TheUnitVector();
+    do_pml_Hi[lev] = amrex::IntVect::TheUnitVector();
+    // check if fine patch edges co-incide with domain boundary
+    const amrex::Box levelBox = boxArray(lev).minimalBox();
+    // Domain box at level, lev
+    const amrex::Box DomainBox = Geom(lev).Domain();
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        if (levelBox.smallEnd(idim) == DomainBox.smallEnd(idim)) {
+            do_pml_Lo[lev][idim] = do_pml_Lo[0][idim];
+        }
+        if (levelBox.bigEnd(idim) == DomainBox.bigEnd(idim)) {
+            do_pml_Hi[lev][idim] = do_pml_Hi[0][idim];
         }
     }
+
+#ifdef WARPX_DIM_RZ
+    //In cylindrical geometry, if the edge of the patch is at r=0, do not add PML
+    if ((max_level > 0) && (fine_tag_lo[0]==0.)) {
+        do_pml_Lo[lev][0] = 0;
+    }
+#endif
+    // Note: fill_guards_fields and fill_guards_current are both set to
+    // zero (amrex::IntVect(0)) (what we do with damping BCs does not apply
+    // to the PML, for example in the presence of mesh refinement patches)
+    pml[lev] = std::make_unique<PML>(
+        lev, boxArray(lev), DistributionMap(lev), do_similar_dm_pml,
+        &Geom(lev), &Geom(lev-1),
+        pml_ncell, pml_delta, refRatio(lev-1),
+        dt[lev], nox_fft, noy_fft, noz_fft, grid_type,
+        do_moving_window, pml_has_particles, do_pml_in_domain,
+        psatd_solution_type, J_in_time, rho_in_time, do_pml_dive_cleaning, do_pml_divb_cleaning,
+        amrex::IntVect(0), amrex::IntVect(0),
+        guard_cells.ng_FieldSolver.max(),
+        v_particle_pml,
+        do_pml_Lo[lev], do_pml_Hi[lev]);
 }
 
 void
@@ -10,6 +10,7 @@
 
 #include "Diagnostics/MultiDiagnostics.H"
 #include "Diagnostics/ReducedDiags/MultiReducedDiags.H"
+#include "Parallelization/WarpXComm_K.H"
 #include "EmbeddedBoundary/WarpXFaceInfoBox.H"
 #include "FieldSolver/FiniteDifferenceSolver/HybridPICModel/HybridPICModel.H"
 #include "Initialization/ExternalField.H"
@@ -27,6 +28,7 @@
 #include <AMReX_Config.H>
 #include <AMReX_DistributionMapping.H>
 #include <AMReX_FabFactory.H>
+#include <AMReX_GpuLaunch.H>
 #include <AMReX_IArrayBox.H>
 #include <AMReX_IndexType.H>
 #include <AMReX_LayoutData.H>
@@ -36,6 +38,7 @@
 #include <AMReX_ParIter.H>
 #include <AMReX_ParallelContext.H>
 #include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Periodicity.H>
 #include <AMReX_REAL.H>
 #include <AMReX_Vector.H>
 #include <AMReX_iMultiFab.H>
@@ -45,11 +48,50 @@
 #include <cmath>
 #include <cstddef>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
 using namespace amrex;
 
+namespace
+{
+    /** Fill a fine-patch field by interpolation of the field of the coarser level
+     *
+     * \param[out] mf_fine fine-patch field, on the grids of the fine level
+     * \param[in] mf_crse_lev field of the coarser level, with the same staggering
+     * \param[in] rr refinement ratio between the two levels
+     * \param[in] crse_period periodicity of the coarser level
+     */
+    void InterpolateFromCoarseLevel (MultiFab& mf_fine, const MultiFab& mf_crse_lev,
+                                     const IntVect& rr, const Periodicity& crse_period)
+    {
+        const int ncomp = mf_fine.nComp();
+        const IntVect stag = mf_fine.ixType().toIntVect();
+        // Coarse data on the coarsened fine grids, with one guard cell for the interpolation stencil
+        MultiFab mf_crse(amrex::coarsen(mf_fine.boxArray(), rr), mf_fine.DistributionMap(), ncomp, 1);
+        mf_crse.setVal(0._rt);
+        mf_crse.ParallelCopy(mf_crse_lev, 0, 0, ncomp, IntVect(0), IntVect(1), crse_period);
+        mf_fine.setVal(0._rt);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(mf_fine, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+            for (int n = 0; n < ncomp; ++n) {
+                Array4<Real> const fine = mf_fine.array(mfi, n);
+                Array4<Real const> const crse = mf_crse.const_array(mfi, n);
+                ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                {
+                    // The fine array is zero, so that this is a pure interpolation of crse
+                    warpx_interp(i, j, k, fine, fine, crse, stag, rr);
+                });
+            }
+        }
+    }
+}
+
 void
 WarpX::CheckLoadBalance (int step)
 {
@@ -66,6 +108,129 @@ WarpX::CheckLoadBalance (int step)
     }
 }
 
+void
+WarpX::CheckRegrid (int step)
+{
+    if (regrid_int > 0 && maxLevel() > 0 && step > 0 && (step % regrid_int == 0))
+    {
+        DynamicRegrid();
+    }
+}
+
+void
+WarpX::DynamicRegrid ()
+{
+    WARPX_PROFILE_REGION("DynamicRegrid");
+    WARPX_PROFILE("WarpX::DynamicRegrid()");
+
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(evolve_scheme == EvolveScheme::Explicit,
+        "warpx.regrid_int is only supported with the explicit evolve scheme");
+
+    // Tag the cells of all levels (with the static and the dynamic criteria)
+    // and rebuild the levels above 0. The fields of the levels whose grids change
+    // are remapped in RemakeLevel and MakeNewLevelFromCoarse.
+    // The grids before regridding are kept to find the levels whose PML must be rebuilt.
+    const int old_finest_level = finest_level;
+    amrex::Vector<amrex::BoxArray> old_ba(old_finest_level+1);
+    amrex::Vector<amrex::DistributionMapping> old_dm(old_finest_level+1);
+    for (int lev = 0; lev <= old_finest_level; ++lev) {
+        old_ba[lev] = boxArray(lev);
+        old_dm[lev] = DistributionMap(lev);
+    }
+
+    m_dynamic_tagging = true;
+    regrid(0, t_new[0]);
+    m_dynamic_tagging = false;
+
+    // Move the particles to the new grids and levels
+    mypc->Redistribute();
+    mypc->defineAllParticleTiles();
+    m_particle_boundary_buffer->redistribute();
+
+    // PML around the refinement patches: only the levels that were added or whose
+    // grids changed are rebuilt, the PML of the levels that were removed is freed
+    if (do_pml) {
+        for (int lev = 1; lev <= finest_level; ++lev) {
+            if (lev > old_finest_level ||
+                boxArray(lev) != old_ba[lev] || DistributionMap(lev) != old_dm[lev]) {
+                InitPMLOnFineLevel(lev);
+                pml[lev]->ComputePMLFactors(dt[lev]);
+            }
+        }
+        for (int lev = finest_level+1; lev <= old_finest_level; ++lev) {
+            pml[lev].reset();
+        }
+    }
+
+    // Buffers around the new refinement patches
+    if (n_field_gather_buffer > 0 || n_current_deposition_buffer > 0) {
+        BuildBufferMasks();
+    }
+
+    // diagnostics & reduced diagnostics
+    multi_diags->Regrid();
+    reduced_diags->LoadBalance();
+
+    if (verbose) {
+        amrex::Print() << Utils::TextMsg::Info(
+            "Regridded: finest level is now " + std::to_string(finest_level));
+    }
+}
+
+void
+WarpX::MakeLevelOnNewGrids (int lev, Real /*time*/, const BoxArray& ba, const DistributionMapping& dm)
+{
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(lev > 0,
+        "MakeLevelOnNewGrids: the grids of level 0 cannot be changed");
+
+    // Keep the fields of the previous grids of this level (if any),
+    // to copy them where the new grids overlap the previous ones
+    std::array<std::unique_ptr<MultiFab>, 3> Efield_fp_old, Bfield_fp_old;
+    std::array<std::unique_ptr<MultiFab>, 3> Efield_cp_old, Bfield_cp_old;
+    for (int idim = 0; idim < 3; ++idim) {
+        Efield_fp_old[idim] = std::move(Efield_fp[lev][idim]);
+        Bfield_fp_old[idim] = std::move(Bfield_fp[lev][idim]);
+        Efield_cp_old[idim] = std::move(Efield_cp[lev][idim]);
+        Bfield_cp_old[idim] = std::move(Bfield_cp[lev][idim]);
+    }
+
+    ClearLevel(lev);
+    AllocLevelData(lev, ba, dm);
+
+    const IntVect rr = refRatio(lev-1);
+    const Periodicity fine_period = Geom(lev).periodicity();
+    const Periodicity crse_period = Geom(lev-1).periodicity();
+
+    for (int idim = 0; idim < 3; ++idim)
+    {
+        // Fine patch: interpolated from the coarser level, and copied from the previous grids where they overlap
+        InterpolateFromCoarseLevel(*Efield_fp[lev][idim], *Efield_fp[lev-1][idim], rr, crse_period);
+        InterpolateFromCoarseLevel(*Bfield_fp[lev][idim], *Bfield_fp[lev-1][idim], rr, crse_period);
+        if (Efield_fp_old[idim]) {
+            Efield_fp[lev][idim]->ParallelCopy(*Efield_fp_old[idim], 0, 0, Efield_fp_old[idim]->nComp(),
+                                               IntVect(0), IntVect(0), fine_period);
+            Bfield_fp[lev][idim]->ParallelCopy(*Bfield_fp_old[idim], 0, 0, Bfield_fp_old[idim]->nComp(),
+                                               IntVect(0), IntVect(0), fine_period);
+        }
+        Efield_fp[lev][idim]->FillBoundary(fine_period);
+        Bfield_fp[lev][idim]->FillBoundary(fine_period);
+
+        // Coarse patch: copied from the coarser level, and from the previous coarse patch where they overlap
+        Efield_cp[lev][idim]->ParallelCopy(*Efield_fp[lev-1][idim], 0, 0, Efield_cp[lev][idim]->nComp(),
+                                           IntVect(0), IntVect(0), crse_period);
+        Bfield_cp[lev][idim]->ParallelCopy(*Bfield_fp[lev-1][idim], 0, 0, Bfield_cp[lev][idim]->nComp(),
+                                           IntVect(0), IntVect(0), crse_period);
+        if (Efield_cp_old[idim]) {
+            Efield_cp[lev][idim]->ParallelCopy(*Efield_cp_old[idim], 0, 0, Efield_cp_old[idim]->nComp(),
+                                               IntVect(0), IntVect(0), crse_period);
+            Bfield_cp[lev][idim]->ParallelCopy(*Bfield_cp_old[idim], 0, 0, Bfield_cp_old[idim]->nComp(),
+                                               IntVect(0), IntVect(0), crse_period);
+        }
+        Efield_cp[lev][idim]->FillBoundary(crse_period);
+        Bfield_cp[lev][idim]->FillBoundary(crse_period);
+    }
+}
+
 void
 WarpX::LoadBalance ()
 {
@@ -165,7 +330,7 @@ WarpX::LoadBalance ()
 }
 
 void
-WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const DistributionMapping& dm)
+WarpX::RemakeLevel (int lev, Real time, const BoxArray& ba, const DistributionMapping& dm)
 {
 
     const auto RemakeMultiFab = [&](auto& mf, const bool redistribute){
@@ -389,7 +554,10 @@ WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const Distributi
 
     } else
     {
-        WARPX_ABORT_WITH_MESSAGE("RemakeLevel: to be implemented");
+        // The grids of the level changed (dynamic regridding). The diagnostics
+        // are updated in DynamicRegrid, once the BoxArrays of all levels are set.
+        MakeLevelOnNewGrids(lev, time, ba, dm);
+        return;
     }
 
     // Re-initialize diagnostic functors that stores pointers to the user-requested fields at level, lev.
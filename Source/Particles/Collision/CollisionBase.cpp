@@ -10,6 +10,9 @@
 
 #include <AMReX_ParmParse.H>
 
+#include <algorithm>
+#include <cmath>
+
 CollisionBase::CollisionBase (const std::string& collision_name)
 {
 
@@ -23,3 +26,21 @@ CollisionBase::CollisionBase (const std::string& collision_name)
         pp_collision_name, "ndt", ndt);
     m_ndt = ndt;
 }
+
+amrex::Real
+CollisionBase::collision_dt (amrex::Real cur_time, amrex::Real dt)
+{
+    using namespace amrex::literals;
+
+    const amrex::Real t_end = cur_time + dt*m_ndt;
+    amrex::Real collision_dt = dt*m_ndt;
+    // The correction is only applied beyond round-off errors
+    if (m_collided_until.has_value() &&
+        std::abs(m_collided_until.value() - cur_time) > 1.e-6_rt*dt) {
+        collision_dt = std::max(t_end - m_collided_until.value(), 0._rt);
+        m_collided_until = std::max(t_end, m_collided_until.value());
+    } else {
+        m_collided_until = t_end;
+    }
+    return collision_dt;
+}
@@ -79,15 +79,24 @@ CollisionHandler::CollisionHandler(MultiParticleContainer const * const mypc)
  *
  * @param cur_time Current time
  * @param dt time step size
+ * @param step current step
+ * @param adaptive_dt whether the time step can change during the simulation
  * @param mypc MultiParticleContainer calling this method
  *
  */
-void CollisionHandler::doCollisions ( amrex::Real cur_time, amrex::Real dt, MultiParticleContainer* mypc)
+void CollisionHandler::doCollisions ( amrex::Real cur_time, amrex::Real dt, int step, bool adaptive_dt,
+                                      MultiParticleContainer* mypc)
 {
 
     for (auto& collision : allcollisions) {
         int const ndt = collision->get_ndt();
-        if ( int(std::floor(cur_time/dt)) % ndt == 0 ) {
+        if (adaptive_dt) {
+            // The number of steps can no longer be obtained from the time: the step index
+            // is used, and the collision time step accounts for the changes of dt
+            if ( step % ndt == 0 ) {
+                collision->doCollisions(cur_time, collision->collision_dt(cur_time, dt), mypc);
+            }
+        } else if ( int(std::floor(cur_time/dt)) % ndt == 0 ) {
             collision->doCollisions(cur_time, dt*ndt, mypc);
         }
     }
@@ -6,6 +6,8 @@
  */
 #include "BreitWheelerEngineWrapper.H"
 
+#include "QedCompactTables.H"
+#include "QedTableGenerationUtils.H"
 #include "Utils/TextMsg.H"
 
 #include <AMReX.H>
@@ -46,7 +48,9 @@ BreitWheelerEngine::build_evolve_functor () const
 {
     AMREX_ALWAYS_ASSERT(m_lookup_tables_initialized);
 
-    return {m_dndt_table.get_view(), m_bw_minimum_chi_phot};
+    return {m_use_compact_tables ? BW_dndt_table_view{} : m_dndt_table.get_view(),
+        m_use_compact_tables ? m_dndt_table_compact.get_view() : BW_dndt_table_compact_view{},
+        m_use_compact_tables, m_bw_minimum_chi_phot, m_rate_update_threshold};
 }
 
 BreitWheelerGeneratePairs
@@ -54,7 +58,9 @@ BreitWheelerEngine::build_pair_functor () const
 {
     AMREX_ALWAYS_ASSERT(m_lookup_tables_initialized);
 
-    return {m_pair_prod_table.get_view()};
+    return {m_use_compact_tables ? BW_pair_prod_table_view{} : m_pair_prod_table.get_view(),
+        m_use_compact_tables ? m_pair_prod_table_compact.get_view() : BW_pair_prod_table_compact_view{},
+        m_use_compact_tables};
 }
 
 bool BreitWheelerEngine::are_lookup_tables_initialized () const
@@ -79,6 +85,8 @@ BreitWheelerEngine::init_lookup_tables_from_raw_data (
 
     m_dndt_table = BW_dndt_table{raw_dndt_table};
     m_pair_prod_table = BW_pair_prod_table{raw_pair_prod_table};
+    m_ctrl_is_known = false;
+    m_use_compact_tables = false;
 
     if (!m_dndt_table.is_init() || !m_pair_prod_table.is_init()) {
         return false;
@@ -98,6 +106,8 @@ void BreitWheelerEngine::init_builtin_tables(
 {
     init_builtin_dndt_table();
     init_builtin_pair_prod_table();
+    m_ctrl_is_known = true;
+    m_use_compact_tables = false;
     m_bw_minimum_chi_phot = bw_minimum_chi_phot;
 
     m_lookup_tables_initialized = true;
@@ -105,7 +115,8 @@ void BreitWheelerEngine::init_builtin_tables(
 
 vector<char> BreitWheelerEngine::export_lookup_tables_data () const
 {
-    if(!m_lookup_tables_initialized) {
+    // The full tables are released when the compact tables are used
+    if(!m_lookup_tables_initialized || m_use_compact_tables) {
         return vector<char>{};
     }
 
@@ -126,6 +137,68 @@ vector<char> BreitWheelerEngine::export_lookup_tables_data () const
     return res;
 }
 
+amrex::ParticleReal
+BreitWheelerEngine::init_compact_tables ()
+{
+    AMREX_ALWAYS_ASSERT(m_lookup_tables_initialized);
+
+    m_use_compact_tables = false;
+    if (!m_ctrl_is_known) { return -1.0_prt; }
+
+    namespace pxr_bw = picsar::multi_physics::phys::breit_wheeler;
+    const auto& dndt_params = m_ctrl.dndt_params;
+    const auto& pair_prod_params = m_ctrl.pair_prod_params;
+
+    pxr_bw::dndt_lookup_table_params<float> compact_dndt_params;
+    compact_dndt_params.chi_phot_min = static_cast<float>(dndt_params.chi_phot_min);
+    compact_dndt_params.chi_phot_max = static_cast<float>(dndt_params.chi_phot_max);
+    compact_dndt_params.chi_phot_how_many = dndt_params.chi_phot_how_many;
+    m_dndt_table_compact = BW_dndt_table_compact{compact_dndt_params,
+        QedUtils::compact_table_values(m_dndt_table.serialize(),
+            dndt_params.chi_phot_how_many)};
+
+    pxr_bw::pair_prod_lookup_table_params<float> compact_pair_prod_params;
+    compact_pair_prod_params.chi_phot_min = static_cast<float>(pair_prod_params.chi_phot_min);
+    compact_pair_prod_params.chi_phot_max = static_cast<float>(pair_prod_params.chi_phot_max);
+    compact_pair_prod_params.chi_phot_how_many = pair_prod_params.chi_phot_how_many;
+    compact_pair_prod_params.frac_how_many = pair_prod_params.frac_how_many;
+    m_pair_prod_table_compact = BW_pair_prod_table_compact{compact_pair_prod_params,
+        QedUtils::compact_table_values(m_pair_prod_table.serialize(),
+            pair_prod_params.chi_phot_how_many*pair_prod_params.frac_how_many)};
+
+    amrex::Gpu::synchronize();
+
+    const auto max_rel_diff = std::max(
+        QedUtils::max_rel_diff_1d(m_dndt_table.get_view(), m_dndt_table_compact.get_view(),
+            dndt_params.chi_phot_min, dndt_params.chi_phot_max, dndt_params.chi_phot_how_many),
+        QedUtils::max_rel_diff_2d(m_pair_prod_table.get_view(), m_pair_prod_table_compact.get_view(),
+            pair_prod_params.chi_phot_min, pair_prod_params.chi_phot_max,
+            pair_prod_params.chi_phot_how_many));
+
+    return max_rel_diff;
+}
+
+void
+BreitWheelerEngine::set_ctrl (const PicsarBreitWheelerCtrl ctrl)
+{
+    m_ctrl = ctrl;
+    m_ctrl_is_known = true;
+}
+
+void
+BreitWheelerEngine::use_compact_tables (const bool use_compact)
+{
+    // The functors only access the tables that are used: the others are released
+    m_use_compact_tables = use_compact;
+    if (use_compact) {
+        m_dndt_table = BW_dndt_table{};
+        m_pair_prod_table = BW_pair_prod_table{};
+    } else {
+        m_dndt_table_compact = BW_dndt_table_compact{};
+        m_pair_prod_table_compact = BW_pair_prod_table_compact{};
+    }
+}
+
 PicsarBreitWheelerCtrl
 BreitWheelerEngine::get_default_ctrl() const
 {
@@ -142,6 +215,12 @@ BreitWheelerEngine::get_minimum_chi_phot() const
     return m_bw_minimum_chi_phot;
 }
 
+void
+BreitWheelerEngine::set_rate_update_threshold (const amrex::ParticleReal threshold)
+{
+    m_rate_update_threshold = threshold;
+}
+
 void BreitWheelerEngine::compute_lookup_tables (
     PicsarBreitWheelerCtrl ctrl,
     const amrex::ParticleReal bw_minimum_chi_phot)
@@ -151,6 +230,74 @@ void BreitWheelerEngine::compute_lookup_tables (
     m_dndt_table.generate(true); //Progress bar is displayed
     m_pair_prod_table = BW_pair_prod_table{ctrl.pair_prod_params};
     m_pair_prod_table.generate(true); //Progress bar is displayed
+    m_ctrl = ctrl;
+    m_ctrl_is_known = true;
+    m_use_compact_tables = false;
+    m_bw_minimum_chi_phot = bw_minimum_chi_phot;
+
+    amrex::Gpu::synchronize();
+
+    m_lookup_tables_initialized = true;
+#else
+    amrex::ignore_unused(ctrl, bw_minimum_chi_phot);
+    WARPX_ABORT_WITH_MESSAGE("WarpX was not compiled with table generation support!");
+#endif
+}
+
+void BreitWheelerEngine::compute_lookup_tables_distributed (
+    PicsarBreitWheelerCtrl ctrl,
+    const amrex::ParticleReal bw_minimum_chi_phot)
+{
+#ifdef WARPX_QED_TABLE_GEN
+    const auto& dndt_params = ctrl.dndt_params;
+    const auto& pair_prod_params = ctrl.pair_prod_params;
+    const int n_dndt = dndt_params.chi_phot_how_many;
+    const int n_frac = pair_prod_params.frac_how_many;
+    const int n_pair_prod = pair_prod_params.chi_phot_how_many*n_frac;
+
+    // Values of both tables: each rank sets the values of the blocks that it generates
+    auto vals = std::vector<amrex::ParticleReal>(n_dndt + n_pair_prod, 0.0_prt);
+
+    const auto [dndt_first, dndt_size] = QedUtils::local_table_block(n_dndt);
+    if (dndt_size > 0) {
+        auto params = dndt_params;
+        params.chi_phot_min = QedUtils::log_axis_point(
+            dndt_params.chi_phot_min, dndt_params.chi_phot_max, n_dndt, dndt_first);
+        params.chi_phot_max = QedUtils::log_axis_point(
+            dndt_params.chi_phot_min, dndt_params.chi_phot_max, n_dndt, dndt_first+dndt_size-1);
+        params.chi_phot_how_many = dndt_size;
+        auto table = BW_dndt_table{params};
+        table.generate(false);
+        QedUtils::copy_table_values(table.serialize(), dndt_size, vals.data() + dndt_first);
+    }
+
+    // The fraction axis does not depend on chi: the pair production table is split along chi only
+    const auto [pair_first, pair_size] = QedUtils::local_table_block(
+        pair_prod_params.chi_phot_how_many);
+    if (pair_size > 0) {
+        auto params = pair_prod_params;
+        params.chi_phot_min = QedUtils::log_axis_point(
+            pair_prod_params.chi_phot_min, pair_prod_params.chi_phot_max,
+            pair_prod_params.chi_phot_how_many, pair_first);
+        params.chi_phot_max = QedUtils::log_axis_point(
+            pair_prod_params.chi_phot_min, pair_prod_params.chi_phot_max,
+            pair_prod_params.chi_phot_how_many, pair_first+pair_size-1);
+        params.chi_phot_how_many = pair_size;
+        auto table = BW_pair_prod_table{params};
+        table.generate(false);
+        QedUtils::copy_table_values(table.serialize(), pair_size*n_frac,
+            vals.data() + n_dndt + pair_first*n_frac);
+    }
+
+    QedUtils::sum_table_values(vals);
+
+    m_dndt_table = BW_dndt_table{dndt_params,
+        std::vector<amrex::ParticleReal>(vals.begin(), vals.begin() + n_dndt)};
+    m_pair_prod_table = BW_pair_prod_table{pair_prod_params,
+        std::vector<amrex::ParticleReal>(vals.begin() + n_dndt, vals.end())};
+    m_ctrl = ctrl;
+    m_ctrl_is_known = true;
+    m_use_compact_tables = false;
     m_bw_minimum_chi_phot = bw_minimum_chi_phot;
 
     amrex::Gpu::synchronize();
@@ -192,6 +339,7 @@ void BreitWheelerEngine::init_builtin_dndt_table()
         -2.66201e+00_prt, -2.70357e+00_prt, -2.74585e+00_prt, -2.78877e+00_prt};
 
     m_dndt_table = BW_dndt_table{dndt_params, vals};
+    m_ctrl.dndt_params = dndt_params;
 }
 
 void BreitWheelerEngine::init_builtin_pair_prod_table()
@@ -1234,5 +1382,6 @@ void BreitWheelerEngine::init_builtin_pair_prod_table()
         4.85839e-01_prt, 4.90564e-01_prt, 4.95284e-01_prt, 5.00000e-01_prt};
 
     m_pair_prod_table = BW_pair_prod_table{pair_prod_params, vals};
+    m_ctrl.pair_prod_params = pair_prod_params;
 }
 //============================================
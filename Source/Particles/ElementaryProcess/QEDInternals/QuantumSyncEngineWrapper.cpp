@@ -6,6 +6,8 @@
  */
 #include "QuantumSyncEngineWrapper.H"
 
+#include "QedCompactTables.H"
+#include "QedTableGenerationUtils.H"
 #include "Utils/TextMsg.H"
 
 #include <AMReX.H>
@@ -45,14 +47,18 @@ QuantumSynchrotronEvolveOpticalDepth QuantumSynchrotronEngine::build_evolve_func
 {
     AMREX_ALWAYS_ASSERT(m_lookup_tables_initialized);
 
-    return {m_dndt_table.get_view(), m_qs_minimum_chi_part};
+    return {m_use_compact_tables ? QS_dndt_table_view{} : m_dndt_table.get_view(),
+        m_use_compact_tables ? m_dndt_table_compact.get_view() : QS_dndt_table_compact_view{},
+        m_use_compact_tables, m_qs_minimum_chi_part, m_rate_update_threshold};
 }
 
 QuantumSynchrotronPhotonEmission QuantumSynchrotronEngine::build_phot_em_functor ()
 {
     AMREX_ALWAYS_ASSERT(m_lookup_tables_initialized);
 
-    return {m_phot_em_table.get_view()};
+    return {m_use_compact_tables ? QS_phot_em_table_view{} : m_phot_em_table.get_view(),
+        m_use_compact_tables ? m_phot_em_table_compact.get_view() : QS_phot_em_table_compact_view{},
+        m_use_compact_tables};
 
 }
 
@@ -78,6 +84,8 @@ QuantumSynchrotronEngine::init_lookup_tables_from_raw_data (
 
     m_dndt_table = QS_dndt_table{raw_dndt_table};
     m_phot_em_table = QS_phot_em_table{raw_phot_em_table};
+    m_ctrl_is_known = false;
+    m_use_compact_tables = false;
 
     if (!m_dndt_table.is_init() || !m_phot_em_table.is_init()) {
         return false;
@@ -97,6 +105,8 @@ void QuantumSynchrotronEngine::init_builtin_tables(
 {
     init_builtin_dndt_table();
     init_builtin_phot_em_table();
+    m_ctrl_is_known = true;
+    m_use_compact_tables = false;
     m_qs_minimum_chi_part = qs_minimum_chi_part;
 
     m_lookup_tables_initialized = true;
@@ -104,7 +114,8 @@ void QuantumSynchrotronEngine::init_builtin_tables(
 
 vector<char> QuantumSynchrotronEngine::export_lookup_tables_data () const
 {
-    if(!m_lookup_tables_initialized) {
+    // The full tables are released when the compact tables are used
+    if(!m_lookup_tables_initialized || m_use_compact_tables) {
         return vector<char>{};
     }
 
@@ -125,6 +136,69 @@ vector<char> QuantumSynchrotronEngine::export_lookup_tables_data () const
     return res;
 }
 
+amrex::ParticleReal
+QuantumSynchrotronEngine::init_compact_tables ()
+{
+    AMREX_ALWAYS_ASSERT(m_lookup_tables_initialized);
+
+    m_use_compact_tables = false;
+    if (!m_ctrl_is_known) { return -1.0_prt; }
+
+    namespace pxr_qs = picsar::multi_physics::phys::quantum_sync;
+    const auto& dndt_params = m_ctrl.dndt_params;
+    const auto& phot_em_params = m_ctrl.phot_em_params;
+
+    pxr_qs::dndt_lookup_table_params<float> compact_dndt_params;
+    compact_dndt_params.chi_part_min = static_cast<float>(dndt_params.chi_part_min);
+    compact_dndt_params.chi_part_max = static_cast<float>(dndt_params.chi_part_max);
+    compact_dndt_params.chi_part_how_many = dndt_params.chi_part_how_many;
+    m_dndt_table_compact = QS_dndt_table_compact{compact_dndt_params,
+        QedUtils::compact_table_values(m_dndt_table.serialize(),
+            dndt_params.chi_part_how_many)};
+
+    pxr_qs::photon_emission_lookup_table_params<float> compact_phot_em_params;
+    compact_phot_em_params.chi_part_min = static_cast<float>(phot_em_params.chi_part_min);
+    compact_phot_em_params.chi_part_max = static_cast<float>(phot_em_params.chi_part_max);
+    compact_phot_em_params.frac_min = static_cast<float>(phot_em_params.frac_min);
+    compact_phot_em_params.chi_part_how_many = phot_em_params.chi_part_how_many;
+    compact_phot_em_params.frac_how_many = phot_em_params.frac_how_many;
+    m_phot_em_table_compact = QS_phot_em_table_compact{compact_phot_em_params,
+        QedUtils::compact_table_values(m_phot_em_table.serialize(),
+            phot_em_params.chi_part_how_many*phot_em_params.frac_how_many)};
+
+    amrex::Gpu::synchronize();
+
+    const auto max_rel_diff = std::max(
+        QedUtils::max_rel_diff_1d(m_dndt_table.get_view(), m_dndt_table_compact.get_view(),
+            dndt_params.chi_part_min, dndt_params.chi_part_max, dndt_params.chi_part_how_many),
+        QedUtils::max_rel_diff_2d(m_phot_em_table.get_view(), m_phot_em_table_compact.get_view(),
+            phot_em_params.chi_part_min, phot_em_params.chi_part_max,
+            phot_em_params.chi_part_how_many));
+
+    return max_rel_diff;
+}
+
+void
+QuantumSynchrotronEngine::set_ctrl (const PicsarQuantumSyncCtrl ctrl)
+{
+    m_ctrl = ctrl;
+    m_ctrl_is_known = true;
+}
+
+void
+QuantumSynchrotronEngine::use_compact_tables (const bool use_compact)
+{
+    // The functors only access the tables that are used: the others are released
+    m_use_compact_tables = use_compact;
+    if (use_compact) {
+        m_dndt_table = QS_dndt_table{};
+        m_phot_em_table = QS_phot_em_table{};
+    } else {
+        m_dndt_table_compact = QS_dndt_table_compact{};
+        m_phot_em_table_compact = QS_phot_em_table_compact{};
+    }
+}
+
 PicsarQuantumSyncCtrl
 QuantumSynchrotronEngine::get_default_ctrl() const
 {
@@ -141,6 +215,12 @@ QuantumSynchrotronEngine::get_minimum_chi_part() const
     return m_qs_minimum_chi_part;
 }
 
+void
+QuantumSynchrotronEngine::set_rate_update_threshold (const amrex::ParticleReal threshold)
+{
+    m_rate_update_threshold = threshold;
+}
+
 void QuantumSynchrotronEngine::compute_lookup_tables (
     PicsarQuantumSyncCtrl ctrl,
     const amrex::ParticleReal qs_minimum_chi_part)
@@ -150,6 +230,74 @@ void QuantumSynchrotronEngine::compute_lookup_tables (
     m_dndt_table.generate(true); //Progress bar is displayed
     m_phot_em_table = QS_phot_em_table{ctrl.phot_em_params};
     m_phot_em_table.generate(true); //Progress bar is displayed
+    m_ctrl = ctrl;
+    m_ctrl_is_known = true;
+    m_use_compact_tables = false;
+    m_qs_minimum_chi_part = qs_minimum_chi_part;
+
+    amrex::Gpu::synchronize();
+
+    m_lookup_tables_initialized = true;
+#else
+    amrex::ignore_unused(ctrl, qs_minimum_chi_part);
+    WARPX_ABORT_WITH_MESSAGE("WarpX was not compiled with table generation support!");
+#endif
+}
+
+void QuantumSynchrotronEngine::compute_lookup_tables_distributed (
+    PicsarQuantumSyncCtrl ctrl,
+    const amrex::ParticleReal qs_minimum_chi_part)
+{
+#ifdef WARPX_QED_TABLE_GEN
+    const auto& dndt_params = ctrl.dndt_params;
+    const auto& phot_em_params = ctrl.phot_em_params;
+    const int n_dndt = dndt_params.chi_part_how_many;
+    const int n_frac = phot_em_params.frac_how_many;
+    const int n_phot_em = phot_em_params.chi_part_how_many*n_frac;
+
+    // Values of both tables: each rank sets the values of the blocks that it generates
+    auto vals = std::vector<amrex::ParticleReal>(n_dndt + n_phot_em, 0.0_prt);
+
+    const auto [dndt_first, dndt_size] = QedUtils::local_table_block(n_dndt);
+    if (dndt_size > 0) {
+        auto params = dndt_params;
+        params.chi_part_min = QedUtils::log_axis_point(
+            dndt_params.chi_part_min, dndt_params.chi_part_max, n_dndt, dndt_first);
+        params.chi_part_max = QedUtils::log_axis_point(
+            dndt_params.chi_part_min, dndt_params.chi_part_max, n_dndt, dndt_first+dndt_size-1);
+        params.chi_part_how_many = dndt_size;
+        auto table = QS_dndt_table{params};
+        table.generate(false);
+        QedUtils::copy_table_values(table.serialize(), dndt_size, vals.data() + dndt_first);
+    }
+
+    // The fraction axis does not depend on chi: the photon emission table is split along chi only
+    const auto [phot_em_first, phot_em_size] = QedUtils::local_table_block(
+        phot_em_params.chi_part_how_many);
+    if (phot_em_size > 0) {
+        auto params = phot_em_params;
+        params.chi_part_min = QedUtils::log_axis_point(
+            phot_em_params.chi_part_min, phot_em_params.chi_part_max,
+            phot_em_params.chi_part_how_many, phot_em_first);
+        params.chi_part_max = QedUtils::log_axis_point(
+            phot_em_params.chi_part_min, phot_em_params.chi_part_max,
+            phot_em_params.chi_part_how_many, phot_em_first+phot_em_size-1);
+        params.chi_part_how_many = phot_em_size;
+        auto table = QS_phot_em_table{params};
+        table.generate(false);
+        QedUtils::copy_table_values(table.serialize(), phot_em_size*n_frac,
+            vals.data() + n_dndt + phot_em_first*n_frac);
+    }
+
+    QedUtils::sum_table_values(vals);
+
+    m_dndt_table = QS_dndt_table{dndt_params,
+        std::vector<amrex::ParticleReal>(vals.begin(), vals.begin() + n_dndt)};
+    m_phot_em_table = QS_phot_em_table{phot_em_params,
+        std::vector<amrex::ParticleReal>(vals.begin() + n_dndt, vals.end())};
+    m_ctrl = ctrl;
+    m_ctrl_is_known = true;
+    m_use_compact_tables = false;
     m_qs_minimum_chi_part = qs_minimum_chi_part;
 
     amrex::Gpu::synchronize();
@@ -192,6 +340,7 @@ void QuantumSynchrotronEngine::init_builtin_dndt_table()
         3.90549e+00_prt, 4.03740e+00_prt, 4.16899e+00_prt, 4.30031e+00_prt};
 
     m_dndt_table = QS_dndt_table{dndt_params, vals};
+    m_ctrl.dndt_params = dndt_params;
 }
 
 
@@ -1237,6 +1386,7 @@ void QuantumSynchrotronEngine::init_builtin_phot_em_table()
         -4.05101e-01_prt, -2.79009e-01_prt, -1.56354e-01_prt, 0.00000e+00_prt};
 
     m_phot_em_table = QS_phot_em_table{phot_em_params, vals};
+    m_ctrl.phot_em_params = phot_em_params;
 }
 
 //============================================
@@ -65,6 +65,7 @@
 #include <AMReX_PODVector.H>
 #include <AMReX_ParIter.H>
 #include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParallelReduce.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX_ParticleTile.H>
 #include <AMReX_Particles.H>
@@ -928,10 +929,10 @@ MultiParticleContainer::doFieldIonization (int lev,
 }
 
 void
-MultiParticleContainer::doCollisions ( Real cur_time, amrex::Real dt )
+MultiParticleContainer::doCollisions ( Real cur_time, amrex::Real dt, int step, bool adaptive_dt )
 {
     WARPX_PROFILE("MultiParticleContainer::doCollisions()");
-    collisionhandler->doCollisions(cur_time, dt, this);
+    collisionhandler->doCollisions(cur_time, dt, step, adaptive_dt, this);
 }
 
 void MultiParticleContainer::doResampling (const int timestep, const bool verbose)
@@ -1069,6 +1070,53 @@ void MultiParticleContainer::InitQuantumSync ()
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
         m_shr_p_qs_engine->are_lookup_tables_initialized(),
         "Table initialization has failed!");
+
+    amrex::ParticleReal rate_update_threshold = 0._prt;
+    if (utils::parser::queryWithParser(pp_qed_qs, "rate_update_threshold", rate_update_threshold)) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(rate_update_threshold >= 0._prt,
+            "qed_qs.rate_update_threshold must be non-negative");
+        m_shr_p_qs_engine->set_rate_update_threshold(rate_update_threshold);
+    }
+
+    bool use_compact_tables = false;
+    pp_qed_qs.query("compact_tables", use_compact_tables);
+    if (use_compact_tables) {
+#ifdef AMREX_SINGLE_PRECISION_PARTICLES
+        ablastr::warn_manager::WMRecordWarning("QED",
+            "qed_qs.compact_tables is ignored, since the Quantum Synchrotron tables are already in single precision.",
+            ablastr::warn_manager::WarnPriority::low);
+#else
+        amrex::ParticleReal tolerance = 1.e-3_prt;
+        utils::parser::queryWithParser(pp_qed_qs, "compact_tables_tolerance", tolerance);
+        auto max_rel_diff = m_shr_p_qs_engine->init_compact_tables();
+        // The same tables must be used on all the ranks: the compact tables are only
+        // used if they could be built, and are accurate enough, on all the ranks
+        int all_built = (max_rel_diff >= 0._prt) ? 1 : 0;
+        amrex::ParallelAllReduce::Min(all_built, ParallelDescriptor::Communicator());
+        amrex::ParallelAllReduce::Max(max_rel_diff, ParallelDescriptor::Communicator());
+        if (all_built == 0) { max_rel_diff = -1._prt; }
+        m_shr_p_qs_engine->use_compact_tables(max_rel_diff >= 0._prt && max_rel_diff <= tolerance);
+        if (max_rel_diff < 0._prt) {
+            ablastr::warn_manager::WMRecordWarning("QED",
+                "The compact Quantum Synchrotron tables can only be built from generated or built-in tables: "
+                "the full tables will be used.",
+                ablastr::warn_manager::WarnPriority::medium);
+        }
+        else if (max_rel_diff > tolerance) {
+            ablastr::warn_manager::WMRecordWarning("QED",
+                "The maximum relative difference between the compact and the full Quantum Synchrotron tables ("
+                + std::to_string(max_rel_diff) + ") exceeds qed_qs.compact_tables_tolerance: "
+                "the full tables will be used.",
+                ablastr::warn_manager::WarnPriority::medium);
+        }
+        else {
+            ablastr::warn_manager::WMRecordWarning("QED",
+                "The compact Quantum Synchrotron tables will be used (maximum relative difference with the full tables: "
+                + std::to_string(max_rel_diff) + ").",
+                ablastr::warn_manager::WarnPriority::low);
+        }
+#endif
+    }
 }
 
 void MultiParticleContainer::InitBreitWheeler ()
@@ -1128,6 +1176,53 @@ void MultiParticleContainer::InitBreitWheeler ()
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
         m_shr_p_bw_engine->are_lookup_tables_initialized(),
         "Table initialization has failed!");
+
+    amrex::ParticleReal rate_update_threshold = 0._prt;
+    if (utils::parser::queryWithParser(pp_qed_bw, "rate_update_threshold", rate_update_threshold)) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(rate_update_threshold >= 0._prt,
+            "qed_bw.rate_update_threshold must be non-negative");
+        m_shr_p_bw_engine->set_rate_update_threshold(rate_update_threshold);
+    }
+
+    bool use_compact_tables = false;
+    pp_qed_bw.query("compact_tables", use_compact_tables);
+    if (use_compact_tables) {
+#ifdef AMREX_SINGLE_PRECISION_PARTICLES
+        ablastr::warn_manager::WMRecordWarning("QED",
+            "qed_bw.compact_tables is ignored, since the Breit Wheeler tables are already in single precision.",
+            ablastr::warn_manager::WarnPriority::low);
+#else
+        amrex::ParticleReal tolerance = 1.e-3_prt;
+        utils::parser::queryWithParser(pp_qed_bw, "compact_tables_tolerance", tolerance);
+        auto max_rel_diff = m_shr_p_bw_engine->init_compact_tables();
+        // The same tables must be used on all the ranks: the compact tables are only
+        // used if they could be built, and are accurate enough, on all the ranks
+        int all_built = (max_rel_diff >= 0._prt) ? 1 : 0;
+        amrex::ParallelAllReduce::Min(all_built, ParallelDescriptor::Communicator());
+        amrex::ParallelAllReduce::Max(max_rel_diff, ParallelDescriptor::Communicator());
+        if (all_built == 0) { max_rel_diff = -1._prt; }
+        m_shr_p_bw_engine->use_compact_tables(max_rel_diff >= 0._prt && max_rel_diff <= tolerance);
+        if (max_rel_diff < 0._prt) {
+            ablastr::warn_manager::WMRecordWarning("QED",
+                "The compact Breit Wheeler tables can only be built from generated or built-in tables: "
+                "the full tables will be used.",
+                ablastr::warn_manager::WarnPriority::medium);
+        }
+        else if (max_rel_diff > tolerance) {
+            ablastr::warn_manager::WMRecordWarning("QED",
+                "The maximum relative difference between the compact and the full Breit Wheeler tables ("
+                + std::to_string(max_rel_diff) + ") exceeds qed_bw.compact_tables_tolerance: "
+                "the full tables will be used.",
+                ablastr::warn_manager::WarnPriority::medium);
+        }
+        else {
+            ablastr::warn_manager::WMRecordWarning("QED",
+                "The compact Breit Wheeler tables will be used (maximum relative difference with the full tables: "
+                + std::to_string(max_rel_diff) + ").",
+                ablastr::warn_manager::WarnPriority::low);
+        }
+#endif
+    }
 }
 
 void
@@ -1136,8 +1231,13 @@ MultiParticleContainer::QuantumSyncGenerateTable ()
     const ParmParse pp_qed_qs("qed_qs");
     std::string table_name;
     pp_qed_qs.query("save_table_in", table_name);
+
+    // In the distributed mode, all the ranks generate a part of the table
+    // and the table is not read back from the file, which is then optional
+    bool distributed_generation = false;
+    pp_qed_qs.query("distributed_table_generation", distributed_generation);
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-        !table_name.empty(),
+        distributed_generation || !table_name.empty(),
         "qed_qs.save_table_in should be provided!");
 
     // qs_minimum_chi_part is the minimum chi parameter to be
@@ -1146,67 +1246,78 @@ MultiParticleContainer::QuantumSyncGenerateTable ()
     amrex::Real qs_minimum_chi_part;
     utils::parser::getWithParser(pp_qed_qs, "chi_min", qs_minimum_chi_part);
 
-    if(ParallelDescriptor::IOProcessor()){
-        PicsarQuantumSyncCtrl ctrl;
-
-        //==Table parameters==
-
-        //--- sub-table 1 (1D)
-        //These parameters are used to pre-compute a function
-        //which appears in the evolution of the optical depth
-
-        //Minimun chi for the table. If a lepton has chi < tab_dndt_chi_min,
-        //chi is considered as if it were equal to tab_dndt_chi_min
-        utils::parser::getWithParser(
-            pp_qed_qs, "tab_dndt_chi_min", ctrl.dndt_params.chi_part_min);
-
-        //Maximum chi for the table. If a lepton has chi > tab_dndt_chi_max,
-        //chi is considered as if it were equal to tab_dndt_chi_max
-        utils::parser::getWithParser(
-            pp_qed_qs, "tab_dndt_chi_max", ctrl.dndt_params.chi_part_max);
-
-        //How many points should be used for chi in the table
-        utils::parser::getWithParser(
-            pp_qed_qs, "tab_dndt_how_many", ctrl.dndt_params.chi_part_how_many);
-        //------
-
-        //--- sub-table 2 (2D)
-        //These parameters are used to pre-compute a function
-        //which is used to extract the properties of the generated
-        //photons.
-
-        //Minimun chi for the table. If a lepton has chi < tab_em_chi_min,
-        //chi is considered as if it were equal to tab_em_chi_min
-        utils::parser::getWithParser(
-            pp_qed_qs, "tab_em_chi_min", ctrl.phot_em_params.chi_part_min);
-
-        //Maximum chi for the table. If a lepton has chi > tab_em_chi_max,
-        //chi is considered as if it were equal to tab_em_chi_max
-        utils::parser::getWithParser(
-            pp_qed_qs, "tab_em_chi_max", ctrl.phot_em_params.chi_part_max);
-
-        //How many points should be used for chi in the table
-        utils::parser::getWithParser(
-            pp_qed_qs, "tab_em_chi_how_many", ctrl.phot_em_params.chi_part_how_many);
-
-        //The other axis of the table is the ratio between the quantum
-        //parameter of the emitted photon and the quantum parameter of the
-        //lepton. This parameter is the minimum ratio to consider for the table.
-        utils::parser::getWithParser(
-            pp_qed_qs, "tab_em_frac_min", ctrl.phot_em_params.frac_min);
-
-        //This parameter is the number of different points to consider for the second
-        //axis
-        utils::parser::getWithParser(
-            pp_qed_qs, "tab_em_frac_how_many", ctrl.phot_em_params.frac_how_many);
-        //====================
-
-        m_shr_p_qs_engine->compute_lookup_tables(ctrl, qs_minimum_chi_part);
-        const auto data = m_shr_p_qs_engine->export_lookup_tables_data();
-        WarpXUtilIO::WriteBinaryDataOnFile(table_name,
-            Vector<char>{data.begin(), data.end()});
+    // The parameters of the table are read on all the ranks: they are needed
+    // to build the compact copy of the table (see init_compact_tables)
+    PicsarQuantumSyncCtrl ctrl;
+
+    //==Table parameters==
+
+    //--- sub-table 1 (1D)
+    //These parameters are used to pre-compute a function
+    //which appears in the evolution of the optical depth
+
+    //Minimun chi for the table. If a lepton has chi < tab_dndt_chi_min,
+    //chi is considered as if it were equal to tab_dndt_chi_min
+    utils::parser::getWithParser(
+        pp_qed_qs, "tab_dndt_chi_min", ctrl.dndt_params.chi_part_min);
+
+    //Maximum chi for the table. If a lepton has chi > tab_dndt_chi_max,
+    //chi is considered as if it were equal to tab_dndt_chi_max
+    utils::parser::getWithParser(
+        pp_qed_qs, "tab_dndt_chi_max", ctrl.dndt_params.chi_part_max);
+
+    //How many points should be used for chi in the table
+    utils::parser::getWithParser(
+        pp_qed_qs, "tab_dndt_how_many", ctrl.dndt_params.chi_part_how_many);
+    //------
+
+    //--- sub-table 2 (2D)
+    //These parameters are used to pre-compute a function
+    //which is used to extract the properties of the generated
+    //photons.
+
+    //Minimun chi for the table. If a lepton has chi < tab_em_chi_min,
+    //chi is considered as if it were equal to tab_em_chi_min
+    utils::parser::getWithParser(
+        pp_qed_qs, "tab_em_chi_min", ctrl.phot_em_params.chi_part_min);
+
+    //Maximum chi for the table. If a lepton has chi > tab_em_chi_max,
+    //chi is considered as if it were equal to tab_em_chi_max
+    utils::parser::getWithParser(
+        pp_qed_qs, "tab_em_chi_max", ctrl.phot_em_params.chi_part_max);
+
+    //How many points should be used for chi in the table
+    utils::parser::getWithParser(
+        pp_qed_qs, "tab_em_chi_how_many", ctrl.phot_em_params.chi_part_how_many);
+
+    //The other axis of the table is the ratio between the quantum
+    //parameter of the emitted photon and the quantum parameter of the
+    //lepton. This parameter is the minimum ratio to consider for the table.
+    utils::parser::getWithParser(
+        pp_qed_qs, "tab_em_frac_min", ctrl.phot_em_params.frac_min);
+
+    //This parameter is the number of different points to consider for the second
+    //axis
+    utils::parser::getWithParser(
+        pp_qed_qs, "tab_em_frac_how_many", ctrl.phot_em_params.frac_how_many);
+    //====================
+
+    if(distributed_generation || ParallelDescriptor::IOProcessor()){
+        if (distributed_generation) {
+            m_shr_p_qs_engine->compute_lookup_tables_distributed(ctrl, qs_minimum_chi_part);
+        } else {
+            m_shr_p_qs_engine->compute_lookup_tables(ctrl, qs_minimum_chi_part);
+        }
+        if (ParallelDescriptor::IOProcessor() && !table_name.empty()) {
+            const auto data = m_shr_p_qs_engine->export_lookup_tables_data();
+            WarpXUtilIO::WriteBinaryDataOnFile(table_name,
+                Vector<char>{data.begin(), data.end()});
+        }
     }
 
+    // All the ranks already have the table
+    if (distributed_generation) { return; }
+
     ParallelDescriptor::Barrier();
     Vector<char> table_data;
     ParallelDescriptor::ReadAndBcastFile(table_name, table_data);
@@ -1217,6 +1328,7 @@ MultiParticleContainer::QuantumSyncGenerateTable ()
     if(!ParallelDescriptor::IOProcessor()){
         m_shr_p_qs_engine->init_lookup_tables_from_raw_data(
             table_data, qs_minimum_chi_part);
+        m_shr_p_qs_engine->set_ctrl(ctrl);
     }
 }
 
@@ -1226,8 +1338,13 @@ MultiParticleContainer::BreitWheelerGenerateTable ()
     const ParmParse pp_qed_bw("qed_bw");
     std::string table_name;
     pp_qed_bw.query("save_table_in", table_name);
+
+    // In the distributed mode, all the ranks generate a part of the table
+    // and the table is not read back from the file, which is then optional
+    bool distributed_generation = false;
+    pp_qed_bw.query("distributed_table_generation", distributed_generation);
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-        !table_name.empty(),
+        distributed_generation || !table_name.empty(),
         "qed_bw.save_table_in should be provided!");
 
     // bw_minimum_chi_phot is the minimum chi parameter to be
@@ -1236,62 +1353,73 @@ MultiParticleContainer::BreitWheelerGenerateTable ()
     amrex::Real bw_minimum_chi_part;
     utils::parser::getWithParser(pp_qed_bw, "chi_min", bw_minimum_chi_part);
 
-    if(ParallelDescriptor::IOProcessor()){
-        PicsarBreitWheelerCtrl ctrl;
-
-        //==Table parameters==
-
-        //--- sub-table 1 (1D)
-        //These parameters are used to pre-compute a function
-        //which appears in the evolution of the optical depth
-
-        //Minimun chi for the table. If a photon has chi < tab_dndt_chi_min,
-        //an analytical approximation is used.
-        utils::parser::getWithParser(
-            pp_qed_bw, "tab_dndt_chi_min", ctrl.dndt_params.chi_phot_min);
-
-        //Maximum chi for the table. If a photon has chi > tab_dndt_chi_max,
-        //an analytical approximation is used.
-        utils::parser::getWithParser(
-            pp_qed_bw, "tab_dndt_chi_max", ctrl.dndt_params.chi_phot_max);
-
-        //How many points should be used for chi in the table
-        utils::parser::getWithParser(
-            pp_qed_bw, "tab_dndt_how_many", ctrl.dndt_params.chi_phot_how_many);
-        //------
-
-        //--- sub-table 2 (2D)
-        //These parameters are used to pre-compute a function
-        //which is used to extract the properties of the generated
-        //particles.
-
-        //Minimun chi for the table. If a photon has chi < tab_pair_chi_min
-        //chi is considered as it were equal to chi_phot_tpair_min
-        utils::parser::getWithParser(
-            pp_qed_bw, "tab_pair_chi_min", ctrl.pair_prod_params.chi_phot_min);
-
-        //Maximum chi for the table. If a photon has chi > tab_pair_chi_max
-        //chi is considered as it were equal to chi_phot_tpair_max
-        utils::parser::getWithParser(
-            pp_qed_bw, "tab_pair_chi_max", ctrl.pair_prod_params.chi_phot_max);
-
-        //How many points should be used for chi in the table
-        utils::parser::getWithParser(
-            pp_qed_bw, "tab_pair_chi_how_many", ctrl.pair_prod_params.chi_phot_how_many);
-
-        //The other axis of the table is the fraction of the initial energy
-        //'taken away' by the most energetic particle of the pair.
-        //This parameter is the number of different fractions to consider
-        utils::parser::getWithParser(
-            pp_qed_bw, "tab_pair_frac_how_many", ctrl.pair_prod_params.frac_how_many);
-        //====================
-
-        m_shr_p_bw_engine->compute_lookup_tables(ctrl, bw_minimum_chi_part);
-        const auto data = m_shr_p_bw_engine->export_lookup_tables_data();
-        WarpXUtilIO::WriteBinaryDataOnFile(table_name,
-            Vector<char>{data.begin(), data.end()});
+    // The parameters of the table are read on all the ranks: they are needed
+    // to build the compact copy of the table (see init_compact_tables)
+    PicsarBreitWheelerCtrl ctrl;
+
+    //==Table parameters==
+
+    //--- sub-table 1 (1D)
+    //These parameters are used to pre-compute a function
+    //which appears in the evolution of the optical depth
+
+    //Minimun chi for the table. If a photon has chi < tab_dndt_chi_min,
+    //an analytical approximation is used.
+    utils::parser::getWithParser(
+        pp_qed_bw, "tab_dndt_chi_min", ctrl.dndt_params.chi_phot_min);
+
+    //Maximum chi for the table. If a photon has chi > tab_dndt_chi_max,
+    //an analytical approximation is used.
+    utils::parser::getWithParser(
+        pp_qed_bw, "tab_dndt_chi_max", ctrl.dndt_params.chi_phot_max);
+
+    //How many points should be used for chi in the table
+    utils::parser::getWithParser(
+        pp_qed_bw, "tab_dndt_how_many", ctrl.dndt_params.chi_phot_how_many);
+    //------
+
+    //--- sub-table 2 (2D)
+    //These parameters are used to pre-compute a function
+    //which is used to extract the properties of the generated
+    //particles.
+
+    //Minimun chi for the table. If a photon has chi < tab_pair_chi_min
+    //chi is considered as it were equal to chi_phot_tpair_min
+    utils::parser::getWithParser(
+        pp_qed_bw, "tab_pair_chi_min", ctrl.pair_prod_params.chi_phot_min);
+
+    //Maximum chi for the table. If a photon has chi > tab_pair_chi_max
+    //chi is considered as it were equal to chi_phot_tpair_max
+    utils::parser::getWithParser(
+        pp_qed_bw, "tab_pair_chi_max", ctrl.pair_prod_params.chi_phot_max);
+
+    //How many points should be used for chi in the table
+    utils::parser::getWithParser(
+        pp_qed_bw, "tab_pair_chi_how_many", ctrl.pair_prod_params.chi_phot_how_many);
+
+    //The other axis of the table is the fraction of the initial energy
+    //'taken away' by the most energetic particle of the pair.
+    //This parameter is the number of different fractions to consider
+    utils::parser::getWithParser(
+        pp_qed_bw, "tab_pair_frac_how_many", ctrl.pair_prod_params.frac_how_many);
+    //====================
+
+    if(distributed_generation || ParallelDescriptor::IOProcessor()){
+        if (distributed_generation) {
+            m_shr_p_bw_engine->compute_lookup_tables_distributed(ctrl, bw_minimum_chi_part);
+        } else {
+            m_shr_p_bw_engine->compute_lookup_tables(ctrl, bw_minimum_chi_part);
+        }
+        if (ParallelDescriptor::IOProcessor() && !table_name.empty()) {
+            const auto data = m_shr_p_bw_engine->export_lookup_tables_data();
+            WarpXUtilIO::WriteBinaryDataOnFile(table_name,
+                Vector<char>{data.begin(), data.end()});
+        }
     }
 
+    // All the ranks already have the table
+    if (distributed_generation) { return; }
+
     ParallelDescriptor::Barrier();
     Vector<char> table_data;
     ParallelDescriptor::ReadAndBcastFile(table_name, table_data);
@@ -1302,6 +1430,7 @@ MultiParticleContainer::BreitWheelerGenerateTable ()
     if(!ParallelDescriptor::IOProcessor()){
         m_shr_p_bw_engine->init_lookup_tables_from_raw_data(
             table_data, bw_minimum_chi_part);
+        m_shr_p_bw_engine->set_ctrl(ctrl);
     }
 }
 
@@ -0,0 +1,90 @@
+/* This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "ParticleTileColoring.H"
+
+#include "Particles/WarpXParticleContainer.H"
+
+#include <ablastr/warn_manager/WarnManager.H>
+
+#include <AMReX_Box.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_Vector.H>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+using namespace amrex;
+
+void
+ParticleTileColoring::Build (WarpXParticleContainer& pc, int const lev, IntVect const& ng)
+{
+    const BoxArray& ba = pc.ParticleBoxArray(lev);
+    const DistributionMapping& dm = pc.ParticleDistributionMap(lev);
+    const bool do_tiling = WarpXParticleContainer::do_tiling;
+    const IntVect tile_size = do_tiling ? WarpXParticleContainer::tile_size : IntVect(-1);
+
+    if (ba == m_ba && dm == m_dm && tile_size == m_tile_size && ng == m_ng) { return; }
+    m_ba = ba;
+    m_dm = dm;
+    m_tile_size = tile_size;
+    m_ng = ng;
+
+    // Tiles of each grid of this rank
+    std::map<int, Vector<std::pair<int,Box>>> grid_tiles;
+    MFItInfo info;
+    if (do_tiling) { info.EnableTiling(tile_size); }
+    for (MFIter mfi = pc.MakeMFIter(lev, info); mfi.isValid(); ++mfi) {
+        grid_tiles[mfi.index()].emplace_back(mfi.LocalTileIndex(), mfi.tilebox());
+    }
+
+    m_colors.clear();
+    m_valid = true;
+    for (auto const& [grid, tiles] : grid_tiles) {
+        // The tiles of a grid form a Cartesian product: the index of a tile along
+        // each dimension is the position of its lower corner among the sorted lower
+        // corners of the tiles of the grid
+        std::array<std::vector<int>,AMREX_SPACEDIM> corners;
+        for (auto const& tile : tiles) {
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                corners[idim].push_back(tile.second.smallEnd(idim));
+            }
+        }
+        for (auto& c : corners) {
+            std::sort(c.begin(), c.end());
+            c.erase(std::unique(c.begin(), c.end()), c.end());
+        }
+
+        for (auto const& [tile, box] : tiles) {
+            int color = 0;
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                auto const& c = corners[idim];
+                const auto index = std::lower_bound(c.begin(), c.end(), box.smallEnd(idim)) - c.begin();
+                color += static_cast<int>(index % 2) << idim;
+                // The tile that separates two tiles of the same color must be longer
+                // than the guard cells on both sides, plus one point for the nodal staggering
+                if (c.size() > 1 && box.length(idim) < 2*(ng[idim]+1)) { m_valid = false; }
+            }
+            m_colors[{grid, tile}] = color;
+        }
+    }
+    m_ncolors = do_tiling ? (1 << AMREX_SPACEDIM) : 1;
+
+    if (!m_valid) {
+        ablastr::warn_manager::WMRecordWarning("Particles",
+            "The particle tiles are too small for the colored current deposition"
+            " (they must be at least twice as long as the deposition guard cells, plus 2):"
+            " the current is deposited in thread-local buffers instead."
+            " Increase particles.tile_size to use the colored deposition.",
+            ablastr::warn_manager::WarnPriority::low);
+    }
+}
+
+int
+ParticleTileColoring::Color (int const grid, int const tile) const
+{
+    const auto it = m_colors.find({grid, tile});
+    return (it != m_colors.end()) ? it->second : 0;
+}
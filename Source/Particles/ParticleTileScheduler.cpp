@@ -0,0 +1,62 @@
+/* This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "ParticleTileScheduler.H"
+
+#include <AMReX_IntVect.H>
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <utility>
+
+using namespace amrex;
+using namespace amrex::literals;
+
+void
+ParticleTileScheduler::Build (WarpXParticleContainer& pc, int const lev, MFItInfo const& info)
+{
+    // Costs measured the last time the loop was done
+    std::map<std::pair<int,int>, Real> measured_costs;
+    for (int i = 0; i < size(); ++i) {
+        if (m_costs[i] >= 0._rt) {
+            measured_costs[{m_tiles[i].grid, m_tiles[i].tile}] = m_costs[i];
+        }
+    }
+
+    Vector<Tile> tiles;
+    Vector<Real> costs;
+    Vector<Real> num_particles;
+    bool all_measured = true;
+    auto& particles = pc.GetParticles(lev);
+    MFItInfo serial_info = info;
+    serial_info.SetDynamic(false);
+    for (MFIter mfi = pc.MakeMFIter(lev, serial_info); mfi.isValid(); ++mfi) {
+        const std::pair<int,int> key{mfi.index(), mfi.LocalTileIndex()};
+        tiles.push_back(Tile{key.first, key.second, mfi.tilebox(IntVect::TheZeroVector())});
+
+        const auto it_particles = particles.find(key);
+        num_particles.push_back((it_particles != particles.end()) ?
+            static_cast<Real>(it_particles->second.numParticles()) : 0._rt);
+
+        const auto it_measured = measured_costs.find(key);
+        all_measured = all_measured && (it_measured != measured_costs.end());
+        costs.push_back(all_measured ? it_measured->second : 0._rt);
+    }
+
+    // The measured costs are only used if they are known for all the tiles,
+    // since they cannot be compared with numbers of particles
+    if (!all_measured) { costs = num_particles; }
+
+    Vector<int> order(tiles.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+        [&costs](int a, int b){ return costs[a] > costs[b]; });
+
+    m_tiles.resize(tiles.size());
+    for (int i = 0; i < static_cast<int>(order.size()); ++i) {
+        m_tiles[i] = tiles[order[i]];
+    }
+    m_costs.assign(m_tiles.size(), -1._rt);
+}
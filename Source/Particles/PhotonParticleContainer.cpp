@@ -18,6 +18,8 @@
 #include "Particles/Pusher/UpdatePositionPhoton.H"
 #include "Particles/WarpXParticleContainer.H"
 #include "Utils/TextMsg.H"
+#include "Utils/WarpXAlgorithmSelection.H"
+#include "Utils/WarpXProfilerWrapper.H"
 #include "WarpX.H"
 
 #include <AMReX_Array.H>
@@ -28,9 +30,11 @@
 #include <AMReX_Extension.H>
 #include <AMReX_FArrayBox.H>
 #include <AMReX_GpuLaunch.H>
+#include <AMReX_GpuAtomic.H>
 #include <AMReX_GpuQualifiers.H>
 #include <AMReX_IndexType.H>
 #include <AMReX_IntVect.H>
+#include <AMReX_LayoutData.H>
 #include <AMReX_PODVector.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX_Particles.H>
@@ -93,6 +97,12 @@ PhotonParticleContainer::PushPX (WarpXParIter& pti,
                                  int lev, int gather_lev,
                                  amrex::Real dt, ScaleFields /*scaleFields*/, DtType a_dt_type)
 {
+    // Without the Breit-Wheeler process, the fields at the positions of the photons are not used
+    if (!NeedsFieldGather()) {
+        PushPositions(pti, offset, np_to_push, dt, a_dt_type);
+        return;
+    }
+
     // Get inverse cell size on gather_lev
     const amrex::XDim3 dinv = WarpX::InvCellSize(std::max(gather_lev,0));
 
@@ -119,15 +129,29 @@ PhotonParticleContainer::PushPX (WarpXParIter& pti,
 #ifdef WARPX_QED
     BreitWheelerEvolveOpticalDepth evolve_opt;
     amrex::ParticleReal* AMREX_RESTRICT p_optical_depth_BW = nullptr;
+    amrex::ParticleReal* AMREX_RESTRICT p_optical_depth_rate_BW = nullptr;
+    amrex::ParticleReal* AMREX_RESTRICT p_optical_depth_chi_BW = nullptr;
     const bool local_has_breit_wheeler = has_breit_wheeler();
     if (local_has_breit_wheeler) {
         evolve_opt = m_shr_p_bw_engine->build_evolve_functor();
         p_optical_depth_BW = pti.GetAttribs(particle_comps["opticalDepthBW"]).dataPtr() + offset;
+        if (particle_comps.find("opticalDepthRateBW") != particle_comps.end()) {
+            p_optical_depth_rate_BW = pti.GetAttribs(particle_comps["opticalDepthRateBW"]).dataPtr() + offset;
+            p_optical_depth_chi_BW = pti.GetAttribs(particle_comps["opticalDepthChiBW"]).dataPtr() + offset;
+        }
     }
 #endif
 
-    auto copyAttribs = CopyParticleAttribs(pti, tmp_particle_data, offset);
-    const int do_copy = (m_do_back_transformed_particles && (a_dt_type!=DtType::SecondHalf) );
+    const bool do_selective_copy = doBackTransformedParticlesSelective() && (a_dt_type!=DtType::SecondHalf);
+    if (do_selective_copy) {
+        CopyBackTransformedParticlesCandidates(pti, offset, np_to_push);
+    }
+    const int do_copy = (m_do_back_transformed_particles && (a_dt_type!=DtType::SecondHalf)
+                         && !do_selective_copy);
+    CopyParticleAttribs copyAttribs;
+    if (do_copy) {
+        copyAttribs = CopyParticleAttribs(pti, tmp_particle_data, offset);
+    }
 
     const auto GetPosition = GetParticlePosition<PIdx>(pti, offset);
     auto SetPosition = SetParticlePosition<PIdx>(pti, offset);
@@ -210,13 +234,21 @@ PhotonParticleContainer::PushPX (WarpXParIter& pti,
 #ifdef WARPX_QED
             [[maybe_unused]] const auto& evolve_opt_tmp = evolve_opt;
             [[maybe_unused]] auto *p_optical_depth_BW_tmp = p_optical_depth_BW;
+            [[maybe_unused]] auto *p_optical_depth_rate_BW_tmp = p_optical_depth_rate_BW;
+            [[maybe_unused]] auto *p_optical_depth_chi_BW_tmp = p_optical_depth_chi_BW;
             [[maybe_unused]] auto *ux_tmp = ux; // for nvhpc
             [[maybe_unused]] auto *uy_tmp = uy;
             [[maybe_unused]] auto *uz_tmp = uz;
             [[maybe_unused]] auto dt_tmp = dt;
             if constexpr (qed_control == has_qed) {
-                evolve_opt(ux[i], uy[i], uz[i], Exp, Eyp, Ezp, Bxp, Byp, Bzp,
-                           dt, p_optical_depth_BW[i]);
+                if (p_optical_depth_rate_BW) {
+                    evolve_opt(ux[i], uy[i], uz[i], Exp, Eyp, Ezp, Bxp, Byp, Bzp,
+                               dt, p_optical_depth_BW[i],
+                               p_optical_depth_rate_BW[i], p_optical_depth_chi_BW[i]);
+                } else {
+                    evolve_opt(ux[i], uy[i], uz[i], Exp, Eyp, Ezp, Bxp, Byp, Bzp,
+                               dt, p_optical_depth_BW[i]);
+                }
             }
 #else
             amrex::ignore_unused(qed_control);
@@ -228,6 +260,80 @@ PhotonParticleContainer::PushPX (WarpXParIter& pti,
     );
 }
 
+void
+PhotonParticleContainer::PushPositions (WarpXParIter& pti, const long offset, const long np_to_push,
+                                        const amrex::Real dt, const DtType a_dt_type)
+{
+    auto& attribs = pti.GetAttribs();
+
+    ParticleReal const* const AMREX_RESTRICT ux = attribs[PIdx::ux].dataPtr() + offset;
+    ParticleReal const* const AMREX_RESTRICT uy = attribs[PIdx::uy].dataPtr() + offset;
+    ParticleReal const* const AMREX_RESTRICT uz = attribs[PIdx::uz].dataPtr() + offset;
+
+    const bool do_selective_copy = doBackTransformedParticlesSelective() && (a_dt_type!=DtType::SecondHalf);
+    if (do_selective_copy) {
+        CopyBackTransformedParticlesCandidates(pti, offset, np_to_push);
+    }
+    const int do_copy = (m_do_back_transformed_particles && (a_dt_type!=DtType::SecondHalf)
+                         && !do_selective_copy);
+    CopyParticleAttribs copyAttribs;
+    if (do_copy) {
+        copyAttribs = CopyParticleAttribs(pti, tmp_particle_data, offset);
+    }
+
+    const auto GetPosition = GetParticlePosition<PIdx>(pti, offset);
+    auto SetPosition = SetParticlePosition<PIdx>(pti, offset);
+
+    amrex::ParallelFor(np_to_push,
+        [=] AMREX_GPU_DEVICE (long i) {
+            if (do_copy) { copyAttribs(i); }
+            ParticleReal x, y, z;
+            GetPosition(i, x, y, z);
+            UpdatePositionPhoton( x, y, z, ux[i], uy[i], uz[i], dt );
+            SetPosition(i, x, y, z);
+        }
+    );
+}
+
+void
+PhotonParticleContainer::EvolveFieldFree (int lev, Real t, Real dt, DtType a_dt_type)
+{
+    WARPX_PROFILE("PhotonParticleContainer::EvolveFieldFree()");
+
+    PrepareBackTransformedParticlesCopy(lev, t, dt, a_dt_type);
+
+    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+    for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
+    {
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            amrex::Gpu::synchronize();
+        }
+        auto wt = static_cast<amrex::Real>(amrex::second());
+
+        if (!do_not_push) {
+            PushPositions(pti, 0, pti.numParticles(), dt, a_dt_type);
+        }
+
+        amrex::Gpu::synchronize();
+
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            wt = static_cast<amrex::Real>(amrex::second()) - wt;
+            amrex::HostDevice::Atomic::Add( &(*cost)[pti.index()], wt);
+        }
+    }
+
+    // Same as at the end of PhysicalParticleContainer::Evolve
+    if (do_splitting && (a_dt_type == DtType::SecondHalf || a_dt_type == DtType::Full) ){
+        SplitParticles(lev);
+    }
+}
+
 void
 PhotonParticleContainer::Evolve (int lev,
                                  const MultiFab& Ex, const MultiFab& Ey, const MultiFab& Ez,
@@ -240,6 +346,13 @@ PhotonParticleContainer::Evolve (int lev,
                                  Real t, Real dt, DtType a_dt_type, bool skip_deposition,
                                  PushType push_type)
 {
+    // When the photons do not need the fields, they are pushed without accessing
+    // the fields of the tiles (gather, NCI filter, mesh refinement buffers)
+    if (push_type == PushType::Explicit && !NeedsFieldGather()) {
+        EvolveFieldFree(lev, t, dt, a_dt_type);
+        return;
+    }
+
     // This does gather, push and deposit.
     // Push and deposit have been re-written for photons
     PhysicalParticleContainer::Evolve (lev,
@@ -375,11 +375,23 @@ PhysicalParticleContainer::PhysicalParticleContainer (AmrCore* amr_core, int isp
     pp_species_name.query("do_qed_quantum_sync", m_do_qed_quantum_sync);
     if (m_do_qed_quantum_sync) {
         AddRealComp("opticalDepthQSR");
+        // The rate of decrease of the optical depth and the quantum parameter at
+        // which it was evaluated are stored if the rate can be reused
+        const ParmParse pp_qed_qs("qed_qs");
+        if (pp_qed_qs.contains("rate_update_threshold")) {
+            AddRealComp("opticalDepthRateQSR");
+            AddRealComp("opticalDepthChiQSR");
+        }
     }
 
     pp_species_name.query("do_qed_breit_wheeler", m_do_qed_breit_wheeler);
     if (m_do_qed_breit_wheeler) {
         AddRealComp("opticalDepthBW");
+        const ParmParse pp_qed_bw("qed_bw");
+        if (pp_qed_bw.contains("rate_update_threshold")) {
+            AddRealComp("opticalDepthRateBW");
+            AddRealComp("opticalDepthChiBW");
+        }
     }
 
     if(m_do_qed_quantum_sync){
@@ -1227,6 +1239,25 @@ PhysicalParticleContainer::AddPlasma (PlasmaInjector const& plasma_injector, int
                 particle_comps["opticalDepthBW"]).data() + old_size;
         }
 
+        // The stored rates of decrease of the optical depths (if any) are set to 0,
+        // so that they are evaluated at the first step of the new particles
+        amrex::ParticleReal* p_optical_depth_rate_QSR = nullptr;
+        amrex::ParticleReal* p_optical_depth_chi_QSR = nullptr;
+        amrex::ParticleReal* p_optical_depth_rate_BW = nullptr;
+        amrex::ParticleReal* p_optical_depth_chi_BW = nullptr;
+        if (loc_has_quantum_sync && particle_comps.find("opticalDepthRateQSR") != particle_comps.end()) {
+            p_optical_depth_rate_QSR = soa.GetRealData(
+                particle_comps["opticalDepthRateQSR"]).data() + old_size;
+            p_optical_depth_chi_QSR = soa.GetRealData(
+                particle_comps["opticalDepthChiQSR"]).data() + old_size;
+        }
+        if (loc_has_breit_wheeler && particle_comps.find("opticalDepthRateBW") != particle_comps.end()) {
+            p_optical_depth_rate_BW = soa.GetRealData(
+                particle_comps["opticalDepthRateBW"]).data() + old_size;
+            p_optical_depth_chi_BW = soa.GetRealData(
+                particle_comps["opticalDepthChiBW"]).data() + old_size;
+        }
+
         //If needed, get the appropriate functors from the engines
         QuantumSynchrotronGetOpticalDepth quantum_sync_get_opt;
         BreitWheelerGetOpticalDepth breit_wheeler_get_opt;
@@ -1419,10 +1450,18 @@ PhysicalParticleContainer::AddPlasma (PlasmaInjector const& plasma_injector, int
 #ifdef WARPX_QED
                 if(loc_has_quantum_sync){
                     p_optical_depth_QSR[ip] = quantum_sync_get_opt(engine);
+                    if (p_optical_depth_rate_QSR) {
+                        p_optical_depth_rate_QSR[ip] = 0._prt;
+                        p_optical_depth_chi_QSR[ip] = 0._prt;
+                    }
                 }
 
                 if(loc_has_breit_wheeler){
                     p_optical_depth_BW[ip] = breit_wheeler_get_opt(engine);
+                    if (p_optical_depth_rate_BW) {
+                        p_optical_depth_rate_BW[ip] = 0._prt;
+                        p_optical_depth_chi_BW[ip] = 0._prt;
+                    }
                 }
 #endif
                 // Initialize user-defined integers with user-defined parser
@@ -1783,6 +1822,25 @@ PhysicalParticleContainer::AddPlasmaFlux (PlasmaInjector const& plasma_injector,
                 particle_comps["opticalDepthBW"]).data() + old_size;
         }
 
+        // The stored rates of decrease of the optical depths (if any) are set to 0,
+        // so that they are evaluated at the first step of the new particles
+        amrex::ParticleReal* p_optical_depth_rate_QSR = nullptr;
+        amrex::ParticleReal* p_optical_depth_chi_QSR = nullptr;
+        amrex::ParticleReal* p_optical_depth_rate_BW = nullptr;
+        amrex::ParticleReal* p_optical_depth_chi_BW = nullptr;
+        if (loc_has_quantum_sync && particle_comps.find("opticalDepthRateQSR") != particle_comps.end()) {
+            p_optical_depth_rate_QSR = soa.GetRealData(
+                particle_comps["opticalDepthRateQSR"]).data() + old_size;
+            p_optical_depth_chi_QSR = soa.GetRealData(
+                particle_comps["opticalDepthChiQSR"]).data() + old_size;
+        }
+        if (loc_has_breit_wheeler && particle_comps.find("opticalDepthRateBW") != particle_comps.end()) {
+            p_optical_depth_rate_BW = soa.GetRealData(
+                particle_comps["opticalDepthRateBW"]).data() + old_size;
+            p_optical_depth_chi_BW = soa.GetRealData(
+                particle_comps["opticalDepthChiBW"]).data() + old_size;
+        }
+
         //If needed, get the appropriate functors from the engines
         QuantumSynchrotronGetOpticalDepth quantum_sync_get_opt;
         BreitWheelerGetOpticalDepth breit_wheeler_get_opt;
@@ -1905,10 +1963,18 @@ PhysicalParticleContainer::AddPlasmaFlux (PlasmaInjector const& plasma_injector,
 #ifdef WARPX_QED
                 if (loc_has_quantum_sync) {
                     p_optical_depth_QSR[ip] = quantum_sync_get_opt(engine);
+                    if (p_optical_depth_rate_QSR) {
+                        p_optical_depth_rate_QSR[ip] = 0._prt;
+                        p_optical_depth_chi_QSR[ip] = 0._prt;
+                    }
                 }
 
                 if(loc_has_breit_wheeler){
                     p_optical_depth_BW[ip] = breit_wheeler_get_opt(engine);
+                    if (p_optical_depth_rate_BW) {
+                        p_optical_depth_rate_BW[ip] = 0._prt;
+                        p_optical_depth_chi_BW[ip] = 0._prt;
+                    }
                 }
 #endif
                 // Initialize user-defined integers with user-defined parser
@@ -2020,7 +2086,7 @@ PhysicalParticleContainer::Evolve (int lev,
                                    MultiFab* rho, MultiFab* crho,
                                    const MultiFab* cEx, const MultiFab* cEy, const MultiFab* cEz,
                                    const MultiFab* cBx, const MultiFab* cBy, const MultiFab* cBz,
-                                   Real /*t*/, Real dt, DtType a_dt_type, bool skip_deposition,
+                                   Real t, Real dt, DtType a_dt_type, bool skip_deposition,
                                    PushType push_type)
 {
 
@@ -2036,20 +2102,53 @@ PhysicalParticleContainer::Evolve (int lev,
 
     const bool has_buffer = cEx || cjx;
 
-    if (m_do_back_transformed_particles)
+    PrepareBackTransformedParticlesCopy(lev, t, dt, a_dt_type);
+
+    // With the suborbit caching of the implicit solvers, the particles that are frozen
+    // are not pushed anymore until the end of the time step: the current that they
+    // deposited when they were frozen is added to jx, jy, jz instead
+    const bool do_suborbit_caching = WarpX::do_particle_suborbit_caching
+        && (push_type == PushType::Implicit) && !do_not_push;
+    if (do_suborbit_caching)
     {
-        for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
-        {
-            const auto np = pti.numParticles();
-            const auto t_lev = pti.GetLevel();
-            const auto index = pti.GetPairIndex();
-            tmp_particle_data.resize(finestLevel()+1);
-            for (int i = 0; i < TmpIdx::nattribs; ++i) {
-                tmp_particle_data[t_lev][index][i].resize(np);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!has_buffer,
+            "The suborbit caching of the implicit solvers does not support mesh refinement buffers");
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!m_do_back_transformed_particles,
+            "The suborbit caching of the implicit solvers does not support back-transformed diagnostics");
+
+        m_suborbit_current.resize(finestLevel()+1);
+        const std::array<const MultiFab*, 3> j_fields = {&jx, &jy, &jz};
+        for (int idir = 0; idir < 3; ++idir) {
+            auto& j_cached = m_suborbit_current[lev][idir];
+            const MultiFab& j_field = *j_fields[idir];
+            if (!j_cached || j_cached->boxArray() != j_field.boxArray()
+                || j_cached->DistributionMap() != j_field.DistributionMap()) {
+                j_cached = std::make_unique<MultiFab>(j_field.boxArray(), j_field.DistributionMap(),
+                                                      j_field.nComp(), j_field.nGrowVect());
+                j_cached->setVal(0._rt);
             }
         }
+
+        if (t != m_suborbit_current_time) {
+            // First nonlinear iteration of the step: no particle is frozen yet
+            // (see WarpX::SaveParticlesAtImplicitStepStart)
+            for (int idir = 0; idir < 3; ++idir) {
+                m_suborbit_current[lev][idir]->setVal(0._rt);
+            }
+            m_suborbit_current_time = t;
+        } else if (!skip_deposition) {
+            MultiFab::Add(jx, *m_suborbit_current[lev][0], 0, 0, jx.nComp(), jx.nGrowVect());
+            MultiFab::Add(jy, *m_suborbit_current[lev][1], 0, 0, jy.nComp(), jy.nGrowVect());
+            MultiFab::Add(jz, *m_suborbit_current[lev][2], 0, 0, jz.nComp(), jz.nGrowVect());
+        }
     }
 
+    // With the colored current deposition, the tiles of one color are done at a time,
+    // and deposit their current directly in jx, jy and jz
+    ParticleTileColoring const* const coloring = GetCurrentDepositionColoring(lev);
+    const int ncolors = (coloring) ? coloring->nColors() : 1;
+    const bool deposit_in_place = (coloring != nullptr);
+
 #ifdef AMREX_USE_OMP
 #pragma omp parallel
 #endif
@@ -2063,7 +2162,7 @@ PhysicalParticleContainer::Evolve (int lev,
         FArrayBox filtered_Ex, filtered_Ey, filtered_Ez;
         FArrayBox filtered_Bx, filtered_By, filtered_Bz;
 
-        for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
+        auto evolve_tile = [&] (WarpXParIter& pti)
         {
             if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
             {
@@ -2124,6 +2223,10 @@ PhysicalParticleContainer::Evolve (int lev,
 
             const long np_current = (cjx) ? nfine_current : np;
 
+            // With the suborbit caching, only the particles that are not frozen are pushed
+            // and deposit their current. They are the first particles of the tile.
+            const long np_active = (do_suborbit_caching) ? CountActiveSuborbits(pti) : np_current;
+
             if (rho && ! skip_deposition && ! do_not_deposit) {
                 // Deposit charge before particle push, in component 0 of MultiFab rho.
 
@@ -2140,7 +2243,7 @@ PhysicalParticleContainer::Evolve (int lev,
 
             if (! do_not_push)
             {
-                const long np_gather = (cEx) ? nfine_gather : np;
+                const long np_gather = (cEx) ? nfine_gather : np_active;
 
                 int e_is_nodal = Ex.is_nodal() and Ey.is_nodal() and Ez.is_nodal();
 
@@ -2219,15 +2322,34 @@ PhysicalParticleContainer::Evolve (int lev,
 
                     // Deposit inside domains
                     DepositCurrent(pti, wp, uxp, uyp, uzp, ion_lev, &jx, &jy, &jz,
-                                   0, np_current, thread_num,
-                                   lev, lev, dt, relative_time, push_type);
+                                   0, np_active, thread_num,
+                                   lev, lev, dt, relative_time, push_type, deposit_in_place);
 
                     if (has_buffer)
                     {
                         // Deposit in buffers
                         DepositCurrent(pti, wp, uxp, uyp, uzp, ion_lev, cjx, cjy, cjz,
                                        np_current, np-np_current, thread_num,
-                                       lev, lev-1, dt, relative_time, push_type);
+                                       lev, lev-1, dt, relative_time, push_type, false);
+                    }
+
+                    if (do_suborbit_caching)
+                    {
+                        // Freeze the particles that converged in this iteration. Their current,
+                        // deposited above, is also kept for the next iterations of the step.
+                        long np_still_active = np_active;
+                        const long np_frozen = PartitionConvergedSuborbits(np_still_active, pti);
+                        if (np_frozen > 0) {
+                            const int* const AMREX_RESTRICT ion_lev_frozen = (do_field_ionization)?
+                                pti.GetiAttribs(particle_icomps["ionizationLevel"]).dataPtr() + np_still_active
+                                : nullptr;
+                            DepositCurrent(pti, wp, uxp, uyp, uzp, ion_lev_frozen,
+                                           m_suborbit_current[lev][0].get(),
+                                           m_suborbit_current[lev][1].get(),
+                                           m_suborbit_current[lev][2].get(),
+                                           np_still_active, np_frozen, thread_num,
+                                           lev, lev, dt, relative_time, push_type, deposit_in_place);
+                        }
                     }
                 } // end of "if electrostatic_solver_id == ElectrostaticSolverAlgo::None"
             } // end of "if do_not_push"
@@ -2258,6 +2380,21 @@ PhysicalParticleContainer::Evolve (int lev,
                 wt = static_cast<amrex::Real>(amrex::second()) - wt;
                 amrex::HostDevice::Atomic::Add( &(*cost)[pti.index()], wt);
             }
+        };
+
+        for (int color = 0; color < ncolors; ++color)
+        {
+            for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
+            {
+                if (coloring && coloring->Color(pti.index(), pti.LocalTileIndex()) != color) { continue; }
+                evolve_tile(pti);
+            }
+#ifdef AMREX_USE_OMP
+            // All the tiles of a color are done before the next color
+            if (ncolors > 1) {
+#pragma omp barrier
+            }
+#endif
         }
     }
     // Split particles at the end of the timestep.
@@ -2807,7 +2944,12 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
     ParticleReal* const AMREX_RESTRICT uy = attribs[PIdx::uy].dataPtr() + offset;
     ParticleReal* const AMREX_RESTRICT uz = attribs[PIdx::uz].dataPtr() + offset;
 
-    const int do_copy = (m_do_back_transformed_particles && (a_dt_type!=DtType::SecondHalf) );
+    const bool do_selective_copy = doBackTransformedParticlesSelective() && (a_dt_type!=DtType::SecondHalf);
+    if (do_selective_copy) {
+        CopyBackTransformedParticlesCandidates(pti, offset, np_to_push);
+    }
+    const int do_copy = (m_do_back_transformed_particles && (a_dt_type!=DtType::SecondHalf)
+                         && !do_selective_copy);
     CopyParticleAttribs copyAttribs;
     if (do_copy) {
         copyAttribs = CopyParticleAttribs(pti, tmp_particle_data, offset);
@@ -2849,10 +2991,16 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
 
     QuantumSynchrotronEvolveOpticalDepth evolve_opt;
     amrex::ParticleReal* AMREX_RESTRICT p_optical_depth_QSR = nullptr;
+    amrex::ParticleReal* AMREX_RESTRICT p_optical_depth_rate_QSR = nullptr;
+    amrex::ParticleReal* AMREX_RESTRICT p_optical_depth_chi_QSR = nullptr;
     const bool local_has_quantum_sync = has_quantum_sync();
     if (local_has_quantum_sync) {
         evolve_opt = m_shr_p_qs_engine->build_evolve_functor();
         p_optical_depth_QSR = pti.GetAttribs(particle_comps["opticalDepthQSR"]).dataPtr()  + offset;
+        if (particle_comps.find("opticalDepthRateQSR") != particle_comps.end()) {
+            p_optical_depth_rate_QSR = pti.GetAttribs(particle_comps["opticalDepthRateQSR"]).dataPtr() + offset;
+            p_optical_depth_chi_QSR = pti.GetAttribs(particle_comps["opticalDepthChiQSR"]).dataPtr() + offset;
+        }
     }
 #endif
 
@@ -2958,12 +3106,21 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
 #ifdef WARPX_QED
         [[maybe_unused]] auto foo_local_has_quantum_sync = local_has_quantum_sync;
         [[maybe_unused]] auto *foo_podq = p_optical_depth_QSR;
+        [[maybe_unused]] auto *foo_podrq = p_optical_depth_rate_QSR;
+        [[maybe_unused]] auto *foo_podcq = p_optical_depth_chi_QSR;
         [[maybe_unused]] const auto& foo_evolve_opt = evolve_opt; // have to do all these for nvcc
         if constexpr (qed_control == has_qed) {
             if (local_has_quantum_sync) {
-                evolve_opt(ux[ip], uy[ip], uz[ip],
-                           Exp, Eyp, Ezp,Bxp, Byp, Bzp,
-                           dt, p_optical_depth_QSR[ip]);
+                if (p_optical_depth_rate_QSR) {
+                    evolve_opt(ux[ip], uy[ip], uz[ip],
+                               Exp, Eyp, Ezp,Bxp, Byp, Bzp,
+                               dt, p_optical_depth_QSR[ip],
+                               p_optical_depth_rate_QSR[ip], p_optical_depth_chi_QSR[ip]);
+                } else {
+                    evolve_opt(ux[ip], uy[ip], uz[ip],
+                               Exp, Eyp, Ezp,Bxp, Byp, Bzp,
+                               dt, p_optical_depth_QSR[ip]);
+                }
             }
         }
 #else
@@ -3067,7 +3224,12 @@ PhysicalParticleContainer::ImplicitPushXP (WarpXParIter& pti,
     ParticleReal* uy_n = pti.GetAttribs(particle_comps["uy_n"]).dataPtr();
     ParticleReal* uz_n = pti.GetAttribs(particle_comps["uz_n"]).dataPtr();
 
-    const int do_copy = (m_do_back_transformed_particles && (a_dt_type!=DtType::SecondHalf) );
+    const bool do_selective_copy = doBackTransformedParticlesSelective() && (a_dt_type!=DtType::SecondHalf);
+    if (do_selective_copy) {
+        CopyBackTransformedParticlesCandidates(pti, offset, np_to_push);
+    }
+    const int do_copy = (m_do_back_transformed_particles && (a_dt_type!=DtType::SecondHalf)
+                         && !do_selective_copy);
     CopyParticleAttribs copyAttribs;
     if (do_copy) {
         copyAttribs = CopyParticleAttribs(pti, tmp_particle_data, offset);
@@ -3091,10 +3253,16 @@ PhysicalParticleContainer::ImplicitPushXP (WarpXParIter& pti,
 
     QuantumSynchrotronEvolveOpticalDepth evolve_opt;
     amrex::ParticleReal* AMREX_RESTRICT p_optical_depth_QSR = nullptr;
+    amrex::ParticleReal* AMREX_RESTRICT p_optical_depth_rate_QSR = nullptr;
+    amrex::ParticleReal* AMREX_RESTRICT p_optical_depth_chi_QSR = nullptr;
     const bool local_has_quantum_sync = has_quantum_sync();
     if (local_has_quantum_sync) {
         evolve_opt = m_shr_p_qs_engine->build_evolve_functor();
         p_optical_depth_QSR = pti.GetAttribs(particle_comps["opticalDepthQSR"]).dataPtr()  + offset;
+        if (particle_comps.find("opticalDepthRateQSR") != particle_comps.end()) {
+            p_optical_depth_rate_QSR = pti.GetAttribs(particle_comps["opticalDepthRateQSR"]).dataPtr() + offset;
+            p_optical_depth_chi_QSR = pti.GetAttribs(particle_comps["opticalDepthChiQSR"]).dataPtr() + offset;
+        }
     }
 #endif
 
@@ -3116,6 +3284,15 @@ PhysicalParticleContainer::ImplicitPushXP (WarpXParIter& pti,
     amrex::Gpu::Buffer<amrex::Long> unconverged_particles({0});
     amrex::Long* unconverged_particles_ptr = unconverged_particles.data();
 
+    // With the suborbit caching, flag the particles whose time-centered velocity
+    // did not change between two nonlinear iterations (see SuborbitState)
+    int* AMREX_RESTRICT suborbit_state = nullptr;
+    if (WarpX::do_particle_suborbit_caching) {
+        suborbit_state = pti.GetiAttribs(particle_icomps["suborbit_state"]).dataPtr() + offset;
+    }
+    const amrex::ParticleReal suborbit_tol2 = WarpX::particle_suborbit_tol_in_implicit_scheme
+                                            * WarpX::particle_suborbit_tol_in_implicit_scheme;
+
     // Using this version of ParallelFor with compile time options
     // improves performance when qed or external EB are not used by reducing
     // register pressure.
@@ -3145,6 +3322,11 @@ PhysicalParticleContainer::ImplicitPushXP (WarpXParIter& pti,
         amrex::ParticleReal zp = z_n[ip];
         const amrex::ParticleReal zp_n = z_n[ip];
 
+        // Time-centered velocity from the previous nonlinear iteration
+        const amrex::ParticleReal ux_prev = ux[ip];
+        const amrex::ParticleReal uy_prev = uy[ip];
+        const amrex::ParticleReal uz_prev = uz[ip];
+
         amrex::ParticleReal dxp, dxp_save;
         amrex::ParticleReal dyp, dyp_save;
         amrex::ParticleReal dzp, dzp_save;
@@ -3235,12 +3417,21 @@ PhysicalParticleContainer::ImplicitPushXP (WarpXParIter& pti,
 #ifdef WARPX_QED
             [[maybe_unused]] auto foo_local_has_quantum_sync = local_has_quantum_sync;
             [[maybe_unused]] auto *foo_podq = p_optical_depth_QSR;
+            [[maybe_unused]] auto *foo_podrq = p_optical_depth_rate_QSR;
+            [[maybe_unused]] auto *foo_podcq = p_optical_depth_chi_QSR;
             [[maybe_unused]] const auto& foo_evolve_opt = evolve_opt; // have to do all these for nvcc
             if constexpr (qed_control == has_qed) {
                 if (local_has_quantum_sync) {
-                    evolve_opt(ux[ip], uy[ip], uz[ip],
-                               Exp, Eyp, Ezp,Bxp, Byp, Bzp,
-                               dt, p_optical_depth_QSR[ip]);
+                    if (p_optical_depth_rate_QSR) {
+                        evolve_opt(ux[ip], uy[ip], uz[ip],
+                                   Exp, Eyp, Ezp,Bxp, Byp, Bzp,
+                                   dt, p_optical_depth_QSR[ip],
+                                   p_optical_depth_rate_QSR[ip], p_optical_depth_chi_QSR[ip]);
+                    } else {
+                        evolve_opt(ux[ip], uy[ip], uz[ip],
+                                   Exp, Eyp, Ezp,Bxp, Byp, Bzp,
+                                   dt, p_optical_depth_QSR[ip]);
+                    }
                 }
             }
 #else
@@ -3273,6 +3464,21 @@ PhysicalParticleContainer::ImplicitPushXP (WarpXParIter& pti,
 
         } // end Picard iterations
 
+        if (suborbit_state) {
+            if (suborbit_state[ip] == SuborbitState::Fresh) {
+                suborbit_state[ip] = SuborbitState::Pushed;
+            } else {
+                const amrex::ParticleReal dux = ux[ip] - ux_prev;
+                const amrex::ParticleReal duy = uy[ip] - uy_prev;
+                const amrex::ParticleReal duz = uz[ip] - uz_prev;
+                const amrex::ParticleReal du2 = dux*dux + duy*duy + duz*duz;
+                const amrex::ParticleReal u2 = ux[ip]*ux[ip] + uy[ip]*uy[ip] + uz[ip]*uz[ip];
+                if (du2 <= suborbit_tol2*u2) {
+                    suborbit_state[ip] = SuborbitState::Converged;
+                }
+            }
+        }
+
     });
 
     auto const num_unconverged_particles = *(unconverged_particles.copyToHost());
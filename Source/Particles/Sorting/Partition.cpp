@@ -14,7 +14,10 @@
 #include <AMReX_GpuDevice.H>
 #include <AMReX_GpuLaunch.H>
 #include <AMReX_Particles.H>
+#include <AMReX_ParticleTransformation.H>
 #include <AMReX_REAL.H>
+#include <AMReX_Reduce.H>
+#include <AMReX_Scan.H>
 #include <AMReX_StructOfArrays.H>
 
 #include <AMReX_BaseFwd.H>
@@ -23,6 +26,18 @@
 
 using namespace amrex;
 
+namespace
+{
+    /** Category of the particles that the particle at index `i` of a tile
+     *  should have, when the tile is partitioned in three parts of sizes
+     *  `n0`, `n01-n0` and `np-n01` (see PartitionParticlesInBuffersIncremental) */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    int partOfTile (long i, long n0, long n01)
+    {
+        return (i < n0) ? 0 : ((i < n01) ? 1 : 2);
+    }
+}
+
 /* \brief Determine which particles deposit/gather in the buffer, and
  *        and reorder the particle arrays accordingly
  *
@@ -57,6 +72,12 @@ PhysicalParticleContainer::PartitionParticlesInBuffers(
 {
     WARPX_PROFILE("PhysicalParticleContainer::PartitionParticlesInBuffers");
 
+    if (WarpX::do_incremental_buffer_partition) {
+        PartitionParticlesInBuffersIncremental( nfine_current, nfine_gather, np,
+            pti, lev, current_masks, gather_masks );
+        return;
+    }
+
     // Initialize temporary arrays
     Gpu::DeviceVector<int> inexflag;
     inexflag.resize(np);
@@ -148,3 +169,270 @@ PhysicalParticleContainer::PartitionParticlesInBuffers(
     // the GPU kernels finish running
     Gpu::streamSynchronize();
 }
+
+/* \brief Same as PartitionParticlesInBuffers, but only the particles that are
+ *        not in the right part of the tile are moved
+ *
+ *  The particle arrays are kept partitioned from one step to the next, so that
+ *  in general only the few particles that crossed the edge of a buffer since the
+ *  last step (or that were added to the tile) need to be moved. The particles of
+ *  each part of the tile are categorized as follows:
+ *  - 0: outside of the larger buffer (first part),
+ *  - 1: inside the larger buffer, but outside of the smaller buffer,
+ *  - 2: inside both buffers (last part).
+ *  Each particle that is in the wrong part is swapped with a particle of
+ *  another part, so that contrary to PartitionParticlesInBuffers, the relative
+ *  order of the particles within each part is not preserved.
+ *
+ * \param nfine_current number of particles that deposit to the fine patch
+ *         (modified by this function)
+ * \param nfine_gather number of particles that gather into the fine patch
+ *         (modified by this function)
+ * \param np total number of particles in this tile
+ * \param pti object that holds the particle information for this tile
+ * \param lev current refinement level
+ * \param current_masks indicates, for each cell, whether that cell is
+ *       in the deposition buffers or in the interior of the fine patch
+ * \param gather_masks indicates, for each cell, whether that cell is
+ *       in the gather buffers or in the interior of the fine patch
+ */
+void
+PhysicalParticleContainer::PartitionParticlesInBuffersIncremental(
+    long& nfine_current, long& nfine_gather, long const np,
+    WarpXParIter& pti, int const lev,
+    iMultiFab const* current_masks,
+    iMultiFab const* gather_masks )
+{
+    WARPX_PROFILE("PhysicalParticleContainer::PartitionParticlesInBuffersIncremental");
+
+    // Select the larger and the smaller buffer
+    bool const gather_is_larger =
+        (WarpX::n_field_gather_buffer >= WarpX::n_current_deposition_buffer);
+    iMultiFab const* lmasks = gather_is_larger ? gather_masks : current_masks;
+    iMultiFab const* smasks = gather_is_larger ? current_masks : gather_masks;
+    int const n_small_buf = gather_is_larger ?
+        WarpX::n_current_deposition_buffer : WarpX::n_field_gather_buffer;
+    bool const same_buffers =
+        (WarpX::n_current_deposition_buffer == WarpX::n_field_gather_buffer);
+    bool const use_small_buffer = !same_buffers && (n_small_buf > 0);
+
+    // For each particle, find the category of the cell where it is located
+    Gpu::DeviceVector<int> category;
+    category.resize(np);
+    int* const AMREX_RESTRICT p_category = category.dataPtr();
+    {
+        const Geometry& geom = Geom(lev);
+        const Box domain = geom.Domain();
+        const auto prob_lo = geom.ProbLoArray();
+        const auto inv_cell_size = geom.InvCellSizeArray();
+        const auto ptd = pti.GetParticleTile().getConstParticleTileData();
+        const Array4<int const> lmask = (*lmasks)[pti].array();
+        const Array4<int const> smask = use_small_buffer ? (*smasks)[pti].array() : lmask;
+        amrex::ParallelFor( np, [=] AMREX_GPU_DEVICE (long i)
+        {
+            IntVect const iv = amrex::getParticleCell(ptd, int(i), prob_lo, inv_cell_size, domain);
+            if (lmask(iv)) {
+                p_category[i] = 0;
+            } else {
+                p_category[i] = (use_small_buffer && smask(iv)) ? 1 : 2;
+            }
+        });
+    }
+
+    // Count the particles in each category
+    ReduceOps<ReduceOpSum, ReduceOpSum> reduce_op;
+    ReduceData<long, long> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+    reduce_op.eval(np, reduce_data,
+        [=] AMREX_GPU_DEVICE (long i) -> ReduceTuple
+        {
+            return {(p_category[i] == 0) ? 1L : 0L, (p_category[i] == 1) ? 1L : 0L};
+        });
+    auto const counts = reduce_data.value();
+    long const n0 = amrex::get<0>(counts);
+    long const n1 = amrex::get<1>(counts);
+
+    if (same_buffers || n0 == np) {
+        nfine_current = nfine_gather = n0;
+    } else if (gather_is_larger) {
+        nfine_gather = n0;
+        if (n_small_buf > 0) { nfine_current = n0 + n1; }
+    } else {
+        nfine_current = n0;
+        if (n_small_buf > 0) { nfine_gather = n0 + n1; }
+    }
+
+    // only deposit / gather to coarsest grid
+    if (m_deposit_on_main_grid && lev > 0) {
+        nfine_current = 0;
+    }
+    if (m_gather_from_main_grid && lev > 0) {
+        nfine_gather = 0;
+    }
+
+    if (nfine_current == np && nfine_gather == np) {
+        Gpu::streamSynchronize();
+        return;
+    }
+
+    long const n01 = n0 + n1;
+
+    // Count the particles that are not in the right part of the tile
+    long const n_misplaced = amrex::Reduce::Sum<long>(np,
+        [=] AMREX_GPU_DEVICE (long i) -> long {
+            return (p_category[i] != partOfTile(i, n0, n01)) ? 1L : 0L;
+        });
+    if (n_misplaced == 0) {
+        // The partition from the previous step is still valid
+        Gpu::streamSynchronize();
+        return;
+    }
+
+    // For each category, pair the misplaced particles of this category with the
+    // positions, in the part of this category, that hold misplaced particles
+    Gpu::DeviceVector<int> src_index;
+    src_index.resize(n_misplaced);
+    Gpu::DeviceVector<int> dst_index;
+    dst_index.resize(n_misplaced);
+    int* const AMREX_RESTRICT p_src = src_index.dataPtr();
+    int* const AMREX_RESTRICT p_dst = dst_index.dataPtr();
+    long offset = 0;
+    for (int icat = 0; icat < 3; ++icat) {
+        long const part_lo = (icat == 0) ? 0 : ((icat == 1) ? n0 : n01);
+        long const part_hi = (icat == 0) ? n0 : ((icat == 1) ? n01 : np);
+        if (part_hi == part_lo) { continue; }
+        int* const AMREX_RESTRICT p_src_cat = p_src + offset;
+        int* const AMREX_RESTRICT p_dst_cat = p_dst + offset;
+        long const n_in = Scan::PrefixSum<long>(np,
+            [=] AMREX_GPU_DEVICE (long i) -> long {
+                return (p_category[i] == icat && partOfTile(i, n0, n01) != icat) ? 1L : 0L;
+            },
+            [=] AMREX_GPU_DEVICE (long i, long const& rank) {
+                if (p_category[i] == icat && partOfTile(i, n0, n01) != icat) { p_src_cat[rank] = int(i); }
+            },
+            Scan::Type::exclusive, Scan::retSum);
+        Scan::PrefixSum<long>(part_hi - part_lo,
+            [=] AMREX_GPU_DEVICE (long i) -> long {
+                return (p_category[part_lo + i] != icat) ? 1L : 0L;
+            },
+            [=] AMREX_GPU_DEVICE (long i, long const& rank) {
+                if (p_category[part_lo + i] != icat) { p_dst_cat[rank] = int(part_lo + i); }
+            },
+            Scan::Type::exclusive, Scan::noRetSum);
+        offset += n_in;
+    }
+
+    // Move the misplaced particles only: copy them to a temporary particle tile
+    // first, since they are all moved to positions held by other misplaced particles
+    ParticleTileType ptile_tmp;
+    ptile_tmp.define(NumRuntimeRealComps(), NumRuntimeIntComps());
+    ptile_tmp.resize(n_misplaced);
+
+    ParticleTileType& ptile = pti.GetParticleTile();
+    amrex::gatherParticles(ptile_tmp, ptile, n_misplaced, p_src);
+    amrex::scatterParticles(ptile, ptile_tmp, n_misplaced, p_dst);
+
+    // Make sure that the temporary particle tile and arrays are not destroyed
+    // before the GPU kernels finish running
+    Gpu::streamSynchronize();
+}
+
+/* \brief Count the particles of the tile that are still pushed by the
+ *        implicit solver when the suborbit caching is on
+ *
+ * The particles that are frozen (SuborbitState::Frozen) are stored at the end
+ * of the tile by PartitionConvergedSuborbits, and the particle arrays are not
+ * reordered otherwise until the end of the time step. Thus, the active
+ * particles are the `np - n_frozen` first particles of the tile.
+ *
+ * \param pti object that holds the particle information for this tile
+ * \return number of particles that are not frozen
+ */
+long
+PhysicalParticleContainer::CountActiveSuborbits (WarpXParIter& pti)
+{
+    const long np = pti.numParticles();
+    const int* const AMREX_RESTRICT suborbit_state =
+        pti.GetiAttribs(particle_icomps["suborbit_state"]).dataPtr();
+
+    ReduceOps<ReduceOpSum> reduce_op;
+    ReduceData<long> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+    reduce_op.eval(np, reduce_data,
+        [=] AMREX_GPU_DEVICE (long ip) -> ReduceTuple
+        {
+            return {(suborbit_state[ip] == SuborbitState::Frozen) ? 1L : 0L};
+        });
+    return np - amrex::get<0>(reduce_data.value());
+}
+
+/* \brief Among the `np_active` first particles of the tile, move the particles
+ *        whose suborbit converged (SuborbitState::Converged) to the end, i.e.
+ *        right before the particles that are already frozen, and freeze them
+ *
+ * \param np_active number of particles that are still pushed
+ *        (modified by this function, to exclude the converged particles)
+ * \param pti object that holds the particle information for this tile
+ * \return number of newly frozen particles, which are now the particles
+ *         [np_active, np_active + n_converged) of the tile
+ */
+long
+PhysicalParticleContainer::PartitionConvergedSuborbits (long& np_active, WarpXParIter& pti)
+{
+    WARPX_PROFILE("PhysicalParticleContainer::PartitionConvergedSuborbits");
+
+    const long np = pti.numParticles();
+    const int* const AMREX_RESTRICT suborbit_state =
+        pti.GetiAttribs(particle_icomps["suborbit_state"]).dataPtr();
+
+    // Initialize temporary arrays
+    Gpu::DeviceVector<int> activeflag;
+    activeflag.resize(np_active);
+    int* const AMREX_RESTRICT p_activeflag = activeflag.dataPtr();
+    Gpu::DeviceVector<int> pid;
+    pid.resize(np);
+
+    amrex::ParallelFor( np_active, [=] AMREX_GPU_DEVICE (long ip)
+    {
+        p_activeflag[ip] = (suborbit_state[ip] != SuborbitState::Converged);
+    });
+    // The frozen particles, at the end of the tile, keep their position
+    fillWithConsecutiveIntegers( pid );
+    auto *const sep = stablePartition( pid.begin(), pid.begin() + np_active, activeflag );
+    long const n_keep = iteratorDistance(pid.begin(), sep);
+    long const n_converged = np_active - n_keep;
+
+    // Reorder the actual particle array, using the `pid` indices
+    if (n_converged > 0 && n_keep > 0)
+    {
+        // Prepare temporary particle tile to copy to
+        ParticleTileType ptile_tmp;
+        ptile_tmp.define(NumRuntimeRealComps(), NumRuntimeIntComps());
+        ptile_tmp.resize(np);
+
+        // Copy and re-order the data of the current particle tile
+        ParticleTileType& ptile = pti.GetParticleTile();
+        amrex::gatherParticles(ptile_tmp, ptile, np, pid.dataPtr());
+        ptile.swap(ptile_tmp);
+
+        // Make sure that the temporary particle tile is not destroyed before
+        // the GPU kernels finish running
+        Gpu::streamSynchronize();
+    }
+    // Make sure that the temporary arrays are not destroyed before
+    // the GPU kernels finish running
+    Gpu::streamSynchronize();
+
+    // Freeze the converged particles, using the reordered state array
+    if (n_converged > 0) {
+        int* const AMREX_RESTRICT new_state =
+            pti.GetiAttribs(particle_icomps["suborbit_state"]).dataPtr() + n_keep;
+        amrex::ParallelFor( n_converged, [=] AMREX_GPU_DEVICE (long ip)
+        {
+            new_state[ip] = SuborbitState::Frozen;
+        });
+    }
+
+    np_active = n_keep;
+    return n_converged;
+}
@@ -59,6 +59,7 @@
 #include <AMReX_ParticleTransformation.H>
 #include <AMReX_ParticleUtil.H>
 #include <AMReX_Random.H>
+#include <AMReX_Scan.H>
 #include <AMReX_Utility.H>
 #ifdef AMREX_USE_EB
 #   include "EmbeddedBoundary/ParticleBoundaryProcess.H"
@@ -340,6 +341,11 @@ WarpXParticleContainer::deleteInvalidParticles () {
  *                       current positions of the particles. When different than 0,
  *                       the particle position will be temporarily modified to match
  *                       the time of the deposition.
+ * \param push_type   Type of particle push (explicit or implicit)
+ * \param deposit_in_place (CPU only) Deposit directly in jx, jy and jz instead of
+ *                         the thread-local arrays. The caller must ensure that
+ *                         no other thread deposits in the same cells at the same
+ *                         time (see ParticleTileColoring).
  */
 void
 WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
@@ -349,7 +355,8 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                                         amrex::MultiFab * const jx, amrex::MultiFab * const jy, amrex::MultiFab * const jz,
                                         long const offset, long const np_to_deposit,
                                         int const thread_num, const int lev, int const depos_lev,
-                                        amrex::Real const dt, amrex::Real const relative_time, PushType push_type)
+                                        amrex::Real const dt, amrex::Real const relative_time, PushType push_type,
+                                        bool const deposit_in_place)
 {
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE((depos_lev==(lev-1)) ||
                                      (depos_lev==(lev  )),
@@ -431,7 +438,7 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
     tilebox.grow(ng_J);
 
 #ifdef AMREX_USE_GPU
-    amrex::ignore_unused(thread_num);
+    amrex::ignore_unused(thread_num, deposit_in_place);
     // GPU, no tiling: j<xyz>_arr point to the full j<xyz> arrays
     auto & jx_fab = jx->get(pti);
     auto & jy_fab = jy->get(pti);
@@ -444,22 +451,25 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
     tby.grow(ng_J);
     tbz.grow(ng_J);
 
-    // CPU, tiling: j<xyz>_arr point to the local_j<xyz>[thread_num] arrays
-    local_jx[thread_num].resize(tbx, jx->nComp());
-    local_jy[thread_num].resize(tby, jy->nComp());
-    local_jz[thread_num].resize(tbz, jz->nComp());
-
-    // local_jx[thread_num] is set to zero
-    local_jx[thread_num].setVal(0.0);
-    local_jy[thread_num].setVal(0.0);
-    local_jz[thread_num].setVal(0.0);
-
-    auto & jx_fab = local_jx[thread_num];
-    auto & jy_fab = local_jy[thread_num];
-    auto & jz_fab = local_jz[thread_num];
-    Array4<Real> const& jx_arr = local_jx[thread_num].array();
-    Array4<Real> const& jy_arr = local_jy[thread_num].array();
-    Array4<Real> const& jz_arr = local_jz[thread_num].array();
+    if (!deposit_in_place) {
+        // CPU, tiling: j<xyz>_arr point to the local_j<xyz>[thread_num] arrays
+        local_jx[thread_num].resize(tbx, jx->nComp());
+        local_jy[thread_num].resize(tby, jy->nComp());
+        local_jz[thread_num].resize(tbz, jz->nComp());
+
+        // local_jx[thread_num] is set to zero
+        local_jx[thread_num].setVal(0.0);
+        local_jy[thread_num].setVal(0.0);
+        local_jz[thread_num].setVal(0.0);
+    }
+
+    // CPU, colored tiles: j<xyz>_arr point to the full j<xyz> arrays
+    auto & jx_fab = deposit_in_place ? jx->get(pti) : local_jx[thread_num];
+    auto & jy_fab = deposit_in_place ? jy->get(pti) : local_jy[thread_num];
+    auto & jz_fab = deposit_in_place ? jz->get(pti) : local_jz[thread_num];
+    Array4<Real> const& jx_arr = jx_fab.array();
+    Array4<Real> const& jy_arr = jy_fab.array();
+    Array4<Real> const& jz_arr = jz_fab.array();
 #endif
 
     const auto GetPosition = GetParticlePosition<PIdx>(pti, offset);
@@ -810,11 +820,13 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
 
 #ifndef AMREX_USE_GPU
     // CPU, tiling: atomicAdd local_j<xyz> into j<xyz>
-    WARPX_PROFILE_VAR_START(blp_accumulate);
-    (*jx)[pti].lockAdd(local_jx[thread_num], tbx, tbx, 0, 0, jx->nComp());
-    (*jy)[pti].lockAdd(local_jy[thread_num], tby, tby, 0, 0, jy->nComp());
-    (*jz)[pti].lockAdd(local_jz[thread_num], tbz, tbz, 0, 0, jz->nComp());
-    WARPX_PROFILE_VAR_STOP(blp_accumulate);
+    if (!deposit_in_place) {
+        WARPX_PROFILE_VAR_START(blp_accumulate);
+        (*jx)[pti].lockAdd(local_jx[thread_num], tbx, tbx, 0, 0, jx->nComp());
+        (*jy)[pti].lockAdd(local_jy[thread_num], tby, tby, 0, 0, jy->nComp());
+        (*jz)[pti].lockAdd(local_jz[thread_num], tbz, tbz, 0, 0, jz->nComp());
+        WARPX_PROFILE_VAR_STOP(blp_accumulate);
+    }
 #endif
 }
 
@@ -827,6 +839,10 @@ WarpXParticleContainer::DepositCurrent (
     auto const finest_level = static_cast<int>(J.size() - 1);
     for (int lev = 0; lev <= finest_level; ++lev)
     {
+        // With the colored deposition, the tiles of one color are done at a time
+        ParticleTileColoring const* const coloring = GetCurrentDepositionColoring(lev);
+        const int ncolors = (coloring) ? coloring->nColors() : 1;
+
         // Loop over particle tiles and deposit current on each level
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
@@ -835,23 +851,35 @@ WarpXParticleContainer::DepositCurrent (
 #else
         const int thread_num = 0;
 #endif
-        for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
+        for (int color = 0; color < ncolors; ++color)
         {
-            const long np = pti.numParticles();
-            const auto & wp = pti.GetAttribs(PIdx::w);
-            const auto & uxp = pti.GetAttribs(PIdx::ux);
-            const auto & uyp = pti.GetAttribs(PIdx::uy);
-            const auto & uzp = pti.GetAttribs(PIdx::uz);
-
-            int* AMREX_RESTRICT ion_lev = nullptr;
-            if (do_field_ionization)
+            for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
             {
-                ion_lev = pti.GetiAttribs(particle_icomps["ionizationLevel"]).dataPtr();
-            }
+                if (coloring && coloring->Color(pti.index(), pti.LocalTileIndex()) != color) { continue; }
 
-            DepositCurrent(pti, wp, uxp, uyp, uzp, ion_lev,
-                           J[lev][0].get(), J[lev][1].get(), J[lev][2].get(),
-                           0, np, thread_num, lev, lev, dt, relative_time, PushType::Explicit);
+                const long np = pti.numParticles();
+                const auto & wp = pti.GetAttribs(PIdx::w);
+                const auto & uxp = pti.GetAttribs(PIdx::ux);
+                const auto & uyp = pti.GetAttribs(PIdx::uy);
+                const auto & uzp = pti.GetAttribs(PIdx::uz);
+
+                int* AMREX_RESTRICT ion_lev = nullptr;
+                if (do_field_ionization)
+                {
+                    ion_lev = pti.GetiAttribs(particle_icomps["ionizationLevel"]).dataPtr();
+                }
+
+                DepositCurrent(pti, wp, uxp, uyp, uzp, ion_lev,
+                               J[lev][0].get(), J[lev][1].get(), J[lev][2].get(),
+                               0, np, thread_num, lev, lev, dt, relative_time, PushType::Explicit,
+                               coloring != nullptr);
+            }
+#ifdef AMREX_USE_OMP
+            // All the tiles of a color are done before the next color
+            if (ncolors > 1) {
+#pragma omp barrier
+            }
+#endif
         }
 #ifdef AMREX_USE_OMP
         }
@@ -859,6 +887,24 @@ WarpXParticleContainer::DepositCurrent (
     }
 }
 
+ParticleTileColoring const*
+WarpXParticleContainer::GetCurrentDepositionColoring (int const lev)
+{
+#ifdef AMREX_USE_GPU
+    amrex::ignore_unused(lev);
+    return nullptr;
+#else
+    if (!WarpX::do_colored_current_deposition) { return nullptr; }
+
+    if (static_cast<int>(m_tile_colorings.size()) <= lev) {
+        m_tile_colorings.resize(lev+1);
+    }
+    ParticleTileColoring& coloring = m_tile_colorings[lev];
+    coloring.Build(*this, lev, WarpX::GetInstance().get_ng_depos_J());
+    return coloring.isValid() ? &coloring : nullptr;
+#endif
+}
+
 /* \brief Charge Deposition for thread thread_num
  * \param pti         Particle iterator
  * \param wp          Array of particle weights
@@ -1422,26 +1468,33 @@ std::array<ParticleReal, 3> WarpXParticleContainer::meanParticleVelocity(bool lo
 
 amrex::ParticleReal WarpXParticleContainer::maxParticleVelocity(bool local) {
 
-    amrex::ParticleReal max_v = 0.0;
+    const amrex::ParticleReal inv_clight_sq = 1.0_prt/PhysConst::c/PhysConst::c;
+
+    ReduceOps<ReduceOpMax> reduce_op;
+    ReduceData<ParticleReal> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
 
     const int nLevels = finestLevel();
     for (int lev = 0; lev <= nLevels; ++lev)
     {
-
-#ifdef AMREX_USE_OMP
-#pragma omp parallel reduction(max:max_v)
-#endif
         for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
         {
-            auto& ux = pti.GetAttribs(PIdx::ux);
-            auto& uy = pti.GetAttribs(PIdx::uy);
-            auto& uz = pti.GetAttribs(PIdx::uz);
-            for (unsigned long i = 0; i < ux.size(); i++) {
-                max_v = std::max(max_v, std::sqrt(ux[i]*ux[i] + uy[i]*uy[i] + uz[i]*uz[i]));
-            }
+            const auto uxp = pti.GetAttribs(PIdx::ux).data();
+            const auto uyp = pti.GetAttribs(PIdx::uy).data();
+            const auto uzp = pti.GetAttribs(PIdx::uz).data();
+
+            const long np = pti.numParticles();
+            reduce_op.eval(np, reduce_data,
+                           [=] AMREX_GPU_DEVICE (int i) -> ReduceTuple
+                           {
+                               const amrex::ParticleReal usq = uxp[i]*uxp[i] + uyp[i]*uyp[i] + uzp[i]*uzp[i];
+                               // |v| = |u|/gamma
+                               return {std::sqrt(usq/(1.0_prt + usq*inv_clight_sq))};
+                           });
         }
     }
 
+    amrex::ParticleReal max_v = amrex::get<0>(reduce_data.value());
     if (!local) { ParallelAllReduce::Max(max_v, ParallelDescriptor::Communicator()); }
     return max_v;
 }
@@ -1521,6 +1574,7 @@ void WarpXParticleContainer::defineAllParticleTiles () noexcept
 
     // Resize the tmp_particle_data (no present in parent class)
     tmp_particle_data.resize(finestLevel()+1);
+    tmp_particle_index.resize(finestLevel()+1);
     for (int lev = 0; lev <= finestLevel(); ++lev)
     {
         for (auto mfi = MakeMFIter(lev); mfi.isValid(); ++mfi)
@@ -1528,10 +1582,166 @@ void WarpXParticleContainer::defineAllParticleTiles () noexcept
             const int grid_id = mfi.index();
             const int tile_id = mfi.LocalTileIndex();
             tmp_particle_data[lev][std::make_pair(grid_id,tile_id)];
+            tmp_particle_index[lev][std::make_pair(grid_id,tile_id)];
         }
     }
 }
 
+void
+WarpXParticleContainer::AddBackTransformedParticlesSnapshots (
+    const amrex::Vector<amrex::Real>& t_lab, const bool selective)
+{
+    m_do_back_transformed_particles_selective = (m_num_back_transformed_diags == 0) ?
+        selective : (m_do_back_transformed_particles_selective && selective);
+    ++m_num_back_transformed_diags;
+    m_back_transformed_t_lab.insert(m_back_transformed_t_lab.end(), t_lab.begin(), t_lab.end());
+}
+
+void
+WarpXParticleContainer::UpdateBackTransformedParticlesWindows (
+    const int lev, const amrex::Real t, const amrex::Real dt)
+{
+    using namespace amrex::literals;
+
+    const auto& geom = Geom(lev);
+    const amrex::Real zmin = geom.ProbLo(WARPX_ZINDEX);
+    const amrex::Real zmax = geom.ProbHi(WARPX_ZINDEX);
+    const amrex::Real gamma_boost = WarpX::gamma_boost;
+    const amrex::Real beta_boost = WarpX::beta_boost;
+    // Maximum distance traveled by a particle during the step, with a safety margin
+    const amrex::Real dz_particle = 1.01_rt * PhysConst::c * dt;
+
+    // The z-plane of a snapshot moves from z_old to z_new during the step.
+    // A particle at z (before the push) can only cross it if z is within
+    // [min(z_old,z_new) - dz_particle, max(z_old,z_new) + dz_particle].
+    amrex::Vector<amrex::Real> windows;
+    for (const amrex::Real t_lab : m_back_transformed_t_lab) {
+        const amrex::Real z_old = (t_lab / gamma_boost - t) * PhysConst::c / beta_boost;
+        const amrex::Real z_new = (t_lab / gamma_boost - (t + dt)) * PhysConst::c / beta_boost;
+        const amrex::Real z_lo = std::min(z_old, z_new) - dz_particle;
+        const amrex::Real z_hi = std::max(z_old, z_new) + dz_particle;
+        // Skip the snapshots whose z-plane is outside of the domain
+        if (z_hi < zmin - dz_particle || z_lo > zmax + dz_particle) { continue; }
+        windows.push_back(z_lo);
+        windows.push_back(z_hi);
+    }
+
+    m_back_transformed_z_windows.resize(windows.size());
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, windows.begin(), windows.end(),
+                          m_back_transformed_z_windows.begin());
+    amrex::Gpu::streamSynchronize();
+}
+
+void
+WarpXParticleContainer::PrepareBackTransformedParticlesCopy (
+    const int lev, const amrex::Real t, const amrex::Real dt, const DtType a_dt_type)
+{
+    if (doBackTransformedParticlesSelective())
+    {
+        // Only the particles that can cross the z-plane of a snapshot are copied
+        // in PushPX, in compact arrays that are reset here (but not for the second
+        // half of a subcycled step, during which the particle data is not copied)
+        if (a_dt_type != DtType::SecondHalf) {
+            UpdateBackTransformedParticlesWindows(lev, t, dt);
+            tmp_particle_data.resize(finestLevel()+1);
+            tmp_particle_index.resize(finestLevel()+1);
+            for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
+            {
+                const auto t_lev = pti.GetLevel();
+                const auto index = pti.GetPairIndex();
+                for (int i = 0; i < TmpIdx::nattribs; ++i) {
+                    tmp_particle_data[t_lev][index][i].resize(0);
+                }
+                tmp_particle_index[t_lev][index].resize(0);
+            }
+        }
+    }
+    else if (m_do_back_transformed_particles)
+    {
+        for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
+        {
+            const auto np = pti.numParticles();
+            const auto t_lev = pti.GetLevel();
+            const auto index = pti.GetPairIndex();
+            tmp_particle_data.resize(finestLevel()+1);
+            for (int i = 0; i < TmpIdx::nattribs; ++i) {
+                tmp_particle_data[t_lev][index][i].resize(np);
+            }
+        }
+    }
+}
+
+void
+WarpXParticleContainer::CopyBackTransformedParticlesCandidates (
+    const WarpXParIter& pti, const long offset, const long np)
+{
+    const auto lev = pti.GetLevel();
+    const auto index = pti.GetPairIndex();
+    auto& tmp_tile = tmp_particle_data[lev].at(index);
+    auto& tmp_index = tmp_particle_index[lev].at(index);
+
+    const int nwindows = static_cast<int>(m_back_transformed_z_windows.size() / 2);
+    if (np == 0 || nwindows == 0) { return; }
+
+    // Flag the particles whose position is within one of the z-windows
+    amrex::Gpu::DeviceVector<int> candidate_flag(np);
+    amrex::Gpu::DeviceVector<int> candidate_index(np);
+    int* const AMREX_RESTRICT p_flag = candidate_flag.dataPtr();
+    int* const AMREX_RESTRICT p_candidate_index = candidate_index.dataPtr();
+    const amrex::Real* const AMREX_RESTRICT windows = m_back_transformed_z_windows.dataPtr();
+    const auto GetPosition = GetParticlePosition<PIdx>(pti, offset);
+
+    amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (long i)
+    {
+        amrex::ParticleReal xp, yp, zp;
+        GetPosition(i, xp, yp, zp);
+        int flag = 0;
+        for (int n = 0; n < nwindows; ++n) {
+            if (zp >= windows[2*n] && zp <= windows[2*n+1]) { flag = 1; }
+        }
+        p_flag[i] = flag;
+    });
+
+    const int ncandidates = amrex::Scan::ExclusiveSum(static_cast<int>(np), p_flag, p_candidate_index);
+    if (ncandidates == 0) { return; }
+
+    // Append the candidates to the compact arrays
+    const auto old_size = static_cast<long>(tmp_index.size());
+    tmp_index.resize(old_size + ncandidates);
+    for (int ia = 0; ia < TmpIdx::nattribs; ++ia) {
+        tmp_tile[ia].resize(old_size + ncandidates);
+    }
+
+    const auto& attribs = pti.GetAttribs();
+    const amrex::ParticleReal* const AMREX_RESTRICT uxp = attribs[PIdx::ux].dataPtr() + offset;
+    const amrex::ParticleReal* const AMREX_RESTRICT uyp = attribs[PIdx::uy].dataPtr() + offset;
+    const amrex::ParticleReal* const AMREX_RESTRICT uzp = attribs[PIdx::uz].dataPtr() + offset;
+
+    amrex::ParticleReal* const AMREX_RESTRICT xpold = tmp_tile[TmpIdx::xold].dataPtr() + old_size;
+    amrex::ParticleReal* const AMREX_RESTRICT ypold = tmp_tile[TmpIdx::yold].dataPtr() + old_size;
+    amrex::ParticleReal* const AMREX_RESTRICT zpold = tmp_tile[TmpIdx::zold].dataPtr() + old_size;
+    amrex::ParticleReal* const AMREX_RESTRICT uxpold = tmp_tile[TmpIdx::uxold].dataPtr() + old_size;
+    amrex::ParticleReal* const AMREX_RESTRICT uypold = tmp_tile[TmpIdx::uyold].dataPtr() + old_size;
+    amrex::ParticleReal* const AMREX_RESTRICT uzpold = tmp_tile[TmpIdx::uzold].dataPtr() + old_size;
+    int* const AMREX_RESTRICT p_index = tmp_index.dataPtr() + old_size;
+
+    amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (long i)
+    {
+        if (p_flag[i] == 0) { return; }
+        const int ic = p_candidate_index[i];
+        amrex::ParticleReal xp, yp, zp;
+        GetPosition(i, xp, yp, zp);
+        xpold[ic] = xp;
+        ypold[ic] = yp;
+        zpold[ic] = zp;
+        uxpold[ic] = uxp[i];
+        uypold[ic] = uyp[i];
+        uzpold[ic] = uzp[i];
+        p_index[ic] = static_cast<int>(i + offset);
+    });
+    amrex::Gpu::streamSynchronize();
+}
+
 // This function is called in Redistribute, just after locate
 void
 WarpXParticleContainer::particlePostLocate(ParticleType& p,
@@ -41,13 +41,20 @@ namespace ParticleUtils
                              MFIter const & mfi,
                              ParticleTileType & ptile) {
 
+        return findParticlesInEachCell(lev, mfi.tilebox(IntVect::TheZeroVector()), ptile);
+    }
+
+    ParticleBins
+    findParticlesInEachCell (int lev,
+                             Box const & cbx,
+                             ParticleTileType & ptile) {
+
         // Extract particle structures for this tile
         int const np = ptile.numParticles();
         auto ptd = ptile.getParticleTileData();
 
         // Extract box properties
         Geometry const& geom = WarpX::GetInstance().Geom(lev);
-        Box const& cbx = mfi.tilebox(IntVect::TheZeroVector()); //Cell-centered box
         const auto lo = lbound(cbx);
         const auto dxi = geom.InvCellSizeArray();
         const auto plo = geom.ProbLoArray();
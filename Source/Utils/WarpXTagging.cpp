@@ -8,13 +8,19 @@
 
 #include <WarpX.H>
 
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/WarpXParticleContainer.H"
+
 #include <AMReX_BaseFab.H>
 #include <AMReX_Config.H>
 #include <AMReX_FabArray.H>
 #include <AMReX_Geometry.H>
+#include <AMReX_GpuAtomic.H>
 #include <AMReX_GpuControl.H>
 #include <AMReX_IntVect.H>
 #include <AMReX_MFIter.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParticleUtil.H>
 #include <AMReX_Parser.H>
 #include <AMReX_REAL.H>
 #include <AMReX_RealVect.H>
@@ -23,6 +29,10 @@
 
 #include <AMReX_BaseFwd.H>
 
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
 using namespace amrex;
 
 void
@@ -35,6 +45,58 @@ WarpX::ErrorEst (int lev, TagBoxArray& tags, Real /*time*/, int /*ngrow*/)
     if (ref_patch_parser) { ref_parser = ref_patch_parser->compile<3>(); }
     const auto ftlo = fine_tag_lo;
     const auto fthi = fine_tag_hi;
+
+    // The dynamic criteria are only evaluated when regridding during the simulation,
+    // since the particles and fields are not yet defined when the grids are first created
+    const bool tag_particle_count = m_dynamic_tagging && (regrid_tag_particle_count > 0);
+    const bool tag_E_gradient = m_dynamic_tagging && (regrid_tag_E_gradient > 0);
+    const auto particle_count_threshold = static_cast<Real>(regrid_tag_particle_count);
+    const Real E_gradient_threshold = regrid_tag_E_gradient;
+
+    // Number of macroparticles of all species in each cell of the level.
+    // The particles of the finer levels (which are inside the current refinement
+    // patches) are also counted, in the cells of this level that contain them,
+    // so that the patches that are still needed are tagged again.
+    std::unique_ptr<MultiFab> particle_count;
+    if (tag_particle_count) {
+        particle_count = std::make_unique<MultiFab>(boxArray(lev), DistributionMap(lev), 1, 0);
+        particle_count->setVal(0._rt);
+        const Box domain = Geom(lev).Domain();
+        const auto inv_cell_size = Geom(lev).InvCellSizeArray();
+        IntVect ratio = IntVect::TheUnitVector();
+        for (int plev = lev; plev <= finest_level; ++plev) {
+            if (plev > lev) { ratio *= refRatio(plev-1); }
+            // Count on the grids of the particle level, coarsened to the cells of this level
+            MultiFab plev_count;
+            MultiFab* count_mf = particle_count.get();
+            if (plev > lev) {
+                plev_count.define(amrex::coarsen(boxArray(plev), ratio), DistributionMap(plev), 1, 0);
+                plev_count.setVal(0._rt);
+                count_mf = &plev_count;
+            }
+            // Only the species are counted, not the laser antennas
+            for (int ispecies = 0; ispecies < mypc->nSpecies(); ++ispecies) {
+                auto& pc = mypc->GetParticleContainer(ispecies);
+                for (WarpXParIter pti(pc, plev); pti.isValid(); ++pti)
+                {
+                    const long np = pti.numParticles();
+                    const Box& count_box = (*count_mf)[pti].box();
+                    const auto ptd = pti.GetParticleTile().getConstParticleTileData();
+                    const Array4<Real> count = (*count_mf)[pti].array();
+                    ParallelFor(np, [=] AMREX_GPU_DEVICE (long ip)
+                    {
+                        const IntVect iv = getParticleCell(ptd, int(ip), problo, inv_cell_size, domain);
+                        if (count_box.contains(iv)) {
+                            Gpu::Atomic::AddNoRet(&count(iv), 1._rt);
+                        }
+                    });
+                }
+            }
+            if (plev > lev) {
+                particle_count->ParallelAdd(plev_count, 0, 0, 1);
+            }
+        }
+    }
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
@@ -65,5 +127,37 @@ WarpX::ErrorEst (int lev, TagBoxArray& tags, Real /*time*/, int /*ngrow*/)
                 fab(i,j,k) = TagBox::SET;
             }
         });
+
+        if (tag_particle_count) {
+            const auto count = particle_count->const_array(mfi);
+            ParallelFor(mfi.validbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                if (count(i,j,k) >= particle_count_threshold) {
+                    fab(i,j,k) = TagBox::SET;
+                }
+            });
+        }
+
+        if (tag_E_gradient) {
+            // Largest variation of any component of E over one cell (centered difference)
+            const auto Ex = Efield_fp[lev][0]->const_array(mfi);
+            const auto Ey = Efield_fp[lev][1]->const_array(mfi);
+            const auto Ez = Efield_fp[lev][2]->const_array(mfi);
+            ParallelFor(mfi.validbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                Real dE = 0._rt;
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    const int di = (idim == 0) ? 1 : 0;
+                    const int dj = (idim == 1) ? 1 : 0;
+                    const int dk = (idim == 2) ? 1 : 0;
+                    dE = std::max(dE, std::abs(Ex(i+di,j+dj,k+dk) - Ex(i-di,j-dj,k-dk)));
+                    dE = std::max(dE, std::abs(Ey(i+di,j+dj,k+dk) - Ey(i-di,j-dj,k-dk)));
+                    dE = std::max(dE, std::abs(Ez(i+di,j+dj,k+dk) - Ez(i-di,j-dj,k-dk)));
+                }
+                if (0.5_rt*dE > E_gradient_threshold) {
+                    fab(i,j,k) = TagBox::SET;
+                }
+            });
+        }
     }
 }
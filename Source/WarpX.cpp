@@ -96,6 +96,7 @@ int WarpX::moving_window_dir = -1;
 Real WarpX::moving_window_v = std::numeric_limits<amrex::Real>::max();
 
 bool WarpX::fft_do_time_averaging = false;
+bool WarpX::fft_rz_mode_parallel = false;
 
 amrex::IntVect WarpX::m_fill_guards_fields  = amrex::IntVect(0);
 amrex::IntVect WarpX::m_fill_guards_current = amrex::IntVect(0);
@@ -117,6 +118,8 @@ short WarpX::electromagnetic_solver_id;
 short WarpX::evolve_scheme;
 int WarpX::max_particle_its_in_implicit_scheme = 21;
 ParticleReal WarpX::particle_tol_in_implicit_scheme = 1.e-10;
+bool WarpX::do_particle_suborbit_caching = false;
+ParticleReal WarpX::particle_suborbit_tol_in_implicit_scheme = 1.e-8;
 short WarpX::psatd_solution_type;
 short WarpX::J_in_time;
 short WarpX::rho_in_time;
@@ -129,6 +132,7 @@ bool WarpX::do_single_precision_comms = false;
 
 bool WarpX::do_shared_mem_charge_deposition = false;
 bool WarpX::do_shared_mem_current_deposition = false;
+bool WarpX::do_colored_current_deposition = false;
 #if defined(WARPX_DIM_3D)
 amrex::IntVect WarpX::shared_tilesize(AMREX_D_DECL(6,6,8));
 #elif (AMREX_SPACEDIM == 2)
@@ -208,6 +212,7 @@ IntVect WarpX::filter_npass_each_dir(1);
 
 int WarpX::n_field_gather_buffer = -1;
 int WarpX::n_current_deposition_buffer = -1;
+bool WarpX::do_incremental_buffer_partition = false;
 
 short WarpX::grid_type;
 amrex::IntVect m_rho_nodal_flag;
@@ -756,6 +761,11 @@ WarpX::ReadParameters ()
                 pp_warpx, "self_fields_max_iters", self_fields_max_iters);
             pp_warpx.query("self_fields_verbosity", self_fields_verbosity);
         }
+        else if (electrostatic_solver_id == ElectrostaticSolverAlgo::Relativistic)
+        {
+            utils::parser::queryWithParser(
+                pp_warpx, "self_fields_group_beta_tolerance", m_self_fields_group_beta_tolerance);
+        }
 
         poisson_solver_id = GetAlgorithmInteger(pp_warpx, "poisson_solver");
 #ifndef WARPX_DIM_3D
@@ -814,6 +824,20 @@ WarpX::ReadParameters ()
 
         utils::parser::queryWithParser(pp_warpx, "const_dt", m_const_dt);
 
+        std::vector<std::string> dt_update_interval_string_vec = {"0"};
+        pp_warpx.queryarr("dt_update_interval", dt_update_interval_string_vec);
+        m_dt_update_interval = utils::parser::IntervalsParser(dt_update_interval_string_vec);
+        if (m_dt_update_interval.isActivated()) {
+            utils::parser::queryWithParser(pp_warpx, "max_dt", m_max_dt);
+            utils::parser::queryWithParser(pp_warpx, "dt_max_growth", m_dt_max_growth);
+            utils::parser::queryWithParser(pp_warpx, "dt_plasma_frequency_resolution",
+                m_dt_plasma_frequency_resolution);
+            utils::parser::queryWithParser(pp_warpx, "dt_target_nonlinear_iterations",
+                m_dt_target_nonlinear_iterations);
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_dt_max_growth >= 1._rt,
+                "warpx.dt_max_growth must be at least 1");
+        }
+
         // Filter currently not working with FDTD solver in RZ geometry: turn OFF by default
         // (see https://github.com/ECP-WarpX/WarpX/issues/1943)
 #ifdef WARPX_DIM_RZ
@@ -883,6 +907,11 @@ WarpX::ReadParameters ()
                 "requested shared memory for current deposition, but shared memory is only available for CUDA or HIP");
 #endif
         pp_warpx.query("shared_mem_current_tpb", shared_mem_current_tpb);
+        pp_warpx.query("do_colored_current_deposition", do_colored_current_deposition);
+#ifdef AMREX_USE_GPU
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!do_colored_current_deposition,
+                "warpx.do_colored_current_deposition is only available on CPU");
+#endif
 
         // initialize the shared tilesize
         Vector<int> vect_shared_tilesize(AMREX_SPACEDIM, 1);
@@ -902,6 +931,7 @@ WarpX::ReadParameters ()
             pp_warpx, "n_field_gather_buffer", n_field_gather_buffer);
         utils::parser::queryWithParser(
             pp_warpx, "n_current_deposition_buffer", n_current_deposition_buffer);
+        pp_warpx.query("do_incremental_buffer_partition", do_incremental_buffer_partition);
 
         amrex::Real quantum_xi_tmp;
         const auto quantum_xi_is_specified =
@@ -1041,11 +1071,33 @@ WarpX::ReadParameters ()
             const bool fine_tag_hi_specified = utils::parser::queryArrWithParser(pp_warpx, "fine_tag_hi", hi);
             std::string ref_patch_function;
             const bool parser_specified = pp_warpx.query("ref_patch_function(x,y,z)",ref_patch_function);
+
+            // Dynamic refinement criteria, evaluated every regrid_int steps
+            utils::parser::queryWithParser(pp_warpx, "regrid_tag_particle_count", regrid_tag_particle_count);
+            utils::parser::queryWithParser(pp_warpx, "regrid_tag_E_gradient", regrid_tag_E_gradient);
+            const bool dynamic_tagging = (regrid_tag_particle_count > 0 || regrid_tag_E_gradient > 0);
+            if (dynamic_tagging) {
+                WARPX_ALWAYS_ASSERT_WITH_MESSAGE(regrid_int > 0,
+                    "warpx.regrid_tag_particle_count and warpx.regrid_tag_E_gradient require warpx.regrid_int > 0");
+            }
+            if (regrid_int > 0) {
+                WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                    electromagnetic_solver_id == ElectromagneticSolverAlgo::Yee ||
+                    electromagnetic_solver_id == ElectromagneticSolverAlgo::CKC,
+                    "warpx.regrid_int is only supported with the Yee and CKC Maxwell solvers");
+                WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!do_subcycling,
+                    "warpx.regrid_int is not supported with warpx.do_subcycling = 1");
+#ifdef AMREX_USE_EB
+                WARPX_ABORT_WITH_MESSAGE("warpx.regrid_int is not supported with embedded boundaries");
+#endif
+            }
+
             WARPX_ALWAYS_ASSERT_WITH_MESSAGE( ((fine_tag_lo_specified && fine_tag_hi_specified) ||
-                                                parser_specified ),
+                                                parser_specified || dynamic_tagging ),
                                                 "For max_level > 0, you need to either set\
                                                 warpx.fine_tag_lo and warpx.fine_tag_hi\
-                                                or warpx.ref_patch_function(x,y,z)");
+                                                or warpx.ref_patch_function(x,y,z)\
+                                                or dynamic refinement criteria with warpx.regrid_int");
 
             if ( (fine_tag_lo_specified && fine_tag_hi_specified) && parser_specified) {
                ablastr::warn_manager::WMRecordWarning("Refined patch", "Both fine_tag_lo,fine_tag_hi\
@@ -1055,7 +1107,7 @@ WarpX::ReadParameters ()
             if (fine_tag_lo_specified && fine_tag_hi_specified) {
                 fine_tag_lo = RealVect{lo};
                 fine_tag_hi = RealVect{hi};
-            } else {
+            } else if (parser_specified) {
                 utils::parser::Store_parserString(pp_warpx, "ref_patch_function(x,y,z)", ref_patch_function);
                 ref_patch_parser = std::make_unique<amrex::Parser>(
                     utils::parser::makeParser(ref_patch_function,{"x","y","z"}));
@@ -1247,6 +1299,11 @@ WarpX::ReadParameters ()
                 "Vay deposition not implemented with multi-J algorithm");
         }
 
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            current_deposition_algo != CurrentDepositionAlgo::Vay ||
+            !do_colored_current_deposition,
+            "Vay deposition not implemented with warpx.do_colored_current_deposition");
+
         if (current_deposition_algo == CurrentDepositionAlgo::Villasenor) {
             WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
                 evolve_scheme == EvolveScheme::SemiImplicitEM ||
@@ -1343,6 +1400,24 @@ WarpX::ReadParameters ()
                     "With implicit and semi-implicit schemes, the momentum conserving field gather is not supported as it would not conserve energy");
         }
 
+        if (m_dt_update_interval.isActivated()) {
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                (electromagnetic_solver_id == ElectromagneticSolverAlgo::None &&
+                 electrostatic_solver_id != ElectrostaticSolverAlgo::None) ||
+                evolve_scheme == EvolveScheme::SemiImplicitEM ||
+                evolve_scheme == EvolveScheme::ThetaImplicitEM,
+                "warpx.dt_update_interval can only be used with the electrostatic solver "
+                "or with the implicit and semi-implicit schemes");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!do_subcycling,
+                "warpx.dt_update_interval cannot be used with subcycling");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(gamma_boost <= 1._rt,
+                "warpx.dt_update_interval cannot be used in a boosted frame, "
+                "since the back-transformed diagnostics assume a constant time step");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_dt_target_nonlinear_iterations <= 0 ||
+                evolve_scheme != EvolveScheme::Explicit,
+                "warpx.dt_target_nonlinear_iterations can only be used with the implicit and semi-implicit schemes");
+        }
+
         // Load balancing parameters
         std::vector<std::string> load_balance_intervals_string_vec = {"0"};
         pp_algo.queryarr("load_balance_intervals", load_balance_intervals_string_vec);
@@ -1576,6 +1651,18 @@ WarpX::ReadParameters ()
 
         pp_psatd.query("do_time_averaging", fft_do_time_averaging);
 
+#ifdef WARPX_DIM_RZ
+        pp_psatd.query("rz_mode_parallel", fft_rz_mode_parallel);
+#   if !defined(AMREX_USE_OMP) || defined(AMREX_USE_GPU)
+        if (fft_rz_mode_parallel) {
+            ablastr::warn_manager::WMRecordWarning(
+                "Spectral solver",
+                "psatd.rz_mode_parallel has no effect without OpenMP or on GPUs.",
+                ablastr::warn_manager::WarnPriority::low);
+        }
+#   endif
+#endif
+
         if (WarpX::current_deposition_algo == CurrentDepositionAlgo::Vay)
         {
             WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
@@ -2051,10 +2138,15 @@ WarpX::MakeNewLevelFromScratch (int lev, Real time, const BoxArray& new_grids,
 
 // This is a virtual function.
 void
-WarpX::MakeNewLevelFromCoarse (int /*lev*/, amrex::Real /*time*/, const amrex::BoxArray& /*ba*/,
-                                         const amrex::DistributionMapping& /*dm*/)
+WarpX::MakeNewLevelFromCoarse (int lev, amrex::Real time, const amrex::BoxArray& ba,
+                                         const amrex::DistributionMapping& dm)
 {
-    WARPX_ABORT_WITH_MESSAGE("MakeNewLevelFromCoarse: To be implemented");
+    MakeLevelOnNewGrids(lev, time, ba, dm);
+
+    // The new level starts at the time of the coarser level
+    istep[lev] = istep[lev-1];
+    t_new[lev] = t_new[lev-1];
+    t_old[lev] = t_old[lev-1];
 }
 
 void
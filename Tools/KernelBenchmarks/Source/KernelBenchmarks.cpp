@@ -0,0 +1,598 @@
+/* This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+/**
+ * Microbenchmarks of the hot kernels of WarpX: current deposition, field gather,
+ * momentum pushers, Yee field update and spectral transforms.
+ *
+ * Each kernel runs on a single synthetic tile, with uniformly distributed particles,
+ * outside of the orchestration of a simulation (no WarpX instance, no MultiFab loops,
+ * no communication). The results are written as JSON lines, one per kernel.
+ * The floating point precisions are those of the build (WarpX_PRECISION and
+ * WarpX_PARTICLE_PRECISION).
+ *
+ * Parameters (command line or inputs file):
+ *   bench.kernels             kernels to run (default: all the kernels of this build)
+ *   bench.shape_order         order of the particle shape, 1 to 4 (default: 3)
+ *   bench.particles_per_cell  number of particles per cell (default: 8)
+ *   bench.tile_size           number of cells of the tile, one value or one per dimension (default: 32)
+ *   bench.repetitions         number of timed calls of each kernel (default: 10)
+ *   bench.output              file to which the results are appended (default: standard output)
+ */
+
+#include "FieldSolver/FiniteDifferenceSolver/FiniteDifferenceAlgorithms/CartesianYeeAlgorithm.H"
+#if defined(WARPX_USE_FFT) && !defined(WARPX_DIM_RZ)
+#   include "FieldSolver/SpectralSolver/SpectralFieldData.H"
+#   include "FieldSolver/SpectralSolver/SpectralKSpace.H"
+#endif
+#include "Initialization/WarpXInit.H"
+#include "Particles/Deposition/CurrentDeposition.H"
+#include "Particles/Gather/FieldGather.H"
+#include "Particles/Pusher/UpdateMomentumBoris.H"
+#include "Particles/Pusher/UpdateMomentumHigueraCary.H"
+#include "Particles/Pusher/UpdateMomentumVay.H"
+#include "Utils/Parser/ParserUtils.H"
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXConst.H"
+
+#include <AMReX.H>
+#include <AMReX_Array.H>
+#include <AMReX_Box.H>
+#include <AMReX_FArrayBox.H>
+#include <AMReX_GpuContainers.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_IntVect.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <AMReX_Random.H>
+#include <AMReX_REAL.H>
+#include <AMReX_Utility.H>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace amrex::literals;
+
+namespace
+{
+    /** Attributes of the synthetic particles */
+    struct BIdx {
+        enum {
+            x = 0, y, z, w, ux, uy, uz,
+            Ex, Ey, Ez, Bx, By, Bz,
+            nattribs
+        };
+    };
+
+    /** Parameters of the benchmarks */
+    struct BenchParams {
+        std::vector<std::string> kernels;
+        int shape_order = 3;
+        int ppc = 8;
+        amrex::IntVect tile_size = amrex::IntVect(32);
+        int repetitions = 10;
+        std::string output;
+    };
+
+    /** Synthetic tile: Yee-staggered fields and uniformly distributed particles */
+    struct Tile {
+        amrex::Box box;
+        amrex::Real dx = 1.e-6_rt;
+        std::array<amrex::FArrayBox,3> E, B, J;
+        std::array<amrex::Gpu::DeviceVector<amrex::ParticleReal>,BIdx::nattribs> attribs;
+        long np = 0;
+
+        [[nodiscard]] amrex::ParticleReal* ptr (int const comp) { return attribs[comp].dataPtr(); }
+    };
+
+    constexpr amrex::ParticleReal charge = -PhysConst::q_e;
+    constexpr amrex::ParticleReal mass = PhysConst::m_e;
+
+    std::vector<std::string> AvailableKernels ()
+    {
+        std::vector<std::string> kernels{"deposition", "gather", "push_boris", "push_vay",
+                                         "push_higuera_cary"};
+#if !defined(WARPX_DIM_RZ)
+        kernels.emplace_back("yee");
+#   if defined(WARPX_USE_FFT)
+        kernels.emplace_back("fft");
+#   endif
+#endif
+        return kernels;
+    }
+
+    BenchParams ReadParameters ()
+    {
+        BenchParams params;
+        const amrex::ParmParse pp("bench");
+
+        params.kernels = AvailableKernels();
+        pp.queryarr("kernels", params.kernels);
+        for (auto const& kernel : params.kernels) {
+            const auto available = AvailableKernels();
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                std::find(available.begin(), available.end(), kernel) != available.end(),
+                "bench.kernels: '" + kernel + "' is not available in this build");
+        }
+
+        utils::parser::queryWithParser(pp, "shape_order", params.shape_order);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(params.shape_order >= 1 && params.shape_order <= 4,
+            "bench.shape_order must be between 1 and 4");
+
+        utils::parser::queryWithParser(pp, "particles_per_cell", params.ppc);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(params.ppc >= 1,
+            "bench.particles_per_cell must be positive");
+
+        std::vector<int> tile_size;
+        if (utils::parser::queryArrWithParser(pp, "tile_size", tile_size)) {
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                tile_size.size() == 1 || tile_size.size() == AMREX_SPACEDIM,
+                "bench.tile_size must have one value or one value per dimension");
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                params.tile_size[idim] = (tile_size.size() == 1) ? tile_size[0] : tile_size[idim];
+            }
+        }
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(params.tile_size.allGT(0),
+            "bench.tile_size must be positive");
+
+        utils::parser::queryWithParser(pp, "repetitions", params.repetitions);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(params.repetitions >= 1,
+            "bench.repetitions must be positive");
+
+        pp.query("output", params.output);
+        return params;
+    }
+
+    /** Grid dimension of the field component comp (x, y or z), -1 if it is not a dimension of the grid */
+    int GridDimension (int const comp)
+    {
+#if defined(WARPX_DIM_3D)
+        return comp;
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+        constexpr std::array<int,3> dims{0, -1, 1};
+        return dims[comp];
+#else
+        constexpr std::array<int,3> dims{-1, -1, 0};
+        return dims[comp];
+#endif
+    }
+
+    /** Index type of the component comp of E and J (B has the opposite staggering) */
+    amrex::IntVect EType (int const comp)
+    {
+        amrex::IntVect type = amrex::IntVect::TheNodeVector();
+        const int idim = GridDimension(comp);
+        if (idim >= 0) { type[idim] = 0; }
+        return type;
+    }
+
+    void InitTile (Tile& tile, BenchParams const& params)
+    {
+        tile.box = amrex::Box(amrex::IntVect(0), params.tile_size - 1);
+        // Guard cells reached by the particle shapes near the edges of the tile
+        const int ng = params.shape_order + 1;
+        for (int comp = 0; comp < 3; ++comp) {
+            const amrex::IntVect etype = EType(comp);
+            const amrex::IntVect btype = amrex::IntVect::TheNodeVector() - etype;
+            const amrex::Box ebox = amrex::grow(amrex::convert(tile.box, etype), ng);
+            const amrex::Box bbox = amrex::grow(amrex::convert(tile.box, btype), ng);
+            tile.E[comp].resize(ebox, 1, amrex::The_Arena());
+            tile.J[comp].resize(ebox, 1, amrex::The_Arena());
+            tile.B[comp].resize(bbox, 1, amrex::The_Arena());
+            tile.E[comp].setVal<amrex::RunOn::Device>(1.e9_rt*(comp+1));
+            tile.J[comp].setVal<amrex::RunOn::Device>(0._rt);
+            tile.B[comp].setVal<amrex::RunOn::Device>(1._rt*(comp+1));
+        }
+
+        tile.np = tile.box.numPts()*params.ppc;
+        for (auto& a : tile.attribs) { a.resize(tile.np); }
+        amrex::GpuArray<amrex::ParticleReal*,BIdx::nattribs> p{};
+        for (int comp = 0; comp < BIdx::nattribs; ++comp) { p[comp] = tile.ptr(comp); }
+
+        const amrex::IntVect ncells = tile.box.length();
+        const amrex::ParticleReal dx = tile.dx;
+        const int ppc = params.ppc;
+        amrex::ParallelForRNG(tile.np,
+            [=] AMREX_GPU_DEVICE (long ip, amrex::RandomEngine const& engine)
+            {
+                // Uniform positions in the cell ip/ppc
+                long cell = ip/ppc;
+                amrex::GpuArray<amrex::ParticleReal,AMREX_SPACEDIM> pos{};
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    const auto idx = static_cast<int>(cell%ncells[idim]);
+                    cell /= ncells[idim];
+                    pos[idim] = (idx + static_cast<amrex::ParticleReal>(amrex::Random(engine)))*dx;
+                }
+#if defined(WARPX_DIM_3D)
+                p[BIdx::x][ip] = pos[0];
+                p[BIdx::y][ip] = pos[1];
+                p[BIdx::z][ip] = pos[2];
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+                p[BIdx::x][ip] = pos[0];
+                p[BIdx::y][ip] = 0._prt;
+                p[BIdx::z][ip] = pos[1];
+#else
+                p[BIdx::x][ip] = 0._prt;
+                p[BIdx::y][ip] = 0._prt;
+                p[BIdx::z][ip] = pos[0];
+#endif
+                p[BIdx::w][ip] = 1.e10_prt/ppc;
+                for (int comp = 0; comp < 3; ++comp) {
+                    const auto r = static_cast<amrex::ParticleReal>(2.*amrex::Random(engine) - 1.);
+                    p[BIdx::ux + comp][ip] = 0.1_prt*PhysConst::c*r;
+                    p[BIdx::Ex + comp][ip] = 1.e9_prt*r;
+                    p[BIdx::Bx + comp][ip] = 1._prt*r;
+                }
+            });
+        amrex::Gpu::streamSynchronize();
+    }
+
+    /** Inverse cell size, as used by WarpX (1 along the directions which are not on the grid) */
+    amrex::XDim3 InvCellSize (Tile const& tile)
+    {
+        const amrex::Real inv_dx = 1._rt/tile.dx;
+#if defined(WARPX_DIM_3D)
+        return amrex::XDim3{inv_dx, inv_dx, inv_dx};
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+        return amrex::XDim3{inv_dx, 1._rt, inv_dx};
+#else
+        return amrex::XDim3{1._rt, 1._rt, inv_dx};
+#endif
+    }
+
+    template <int depos_order>
+    void Deposit (Tile& tile)
+    {
+        amrex::ParticleReal const* const AMREX_RESTRICT x = tile.ptr(BIdx::x);
+        amrex::ParticleReal const* const AMREX_RESTRICT y = tile.ptr(BIdx::y);
+        amrex::ParticleReal const* const AMREX_RESTRICT z = tile.ptr(BIdx::z);
+        amrex::ParticleReal const* const AMREX_RESTRICT w = tile.ptr(BIdx::w);
+        amrex::ParticleReal const* const AMREX_RESTRICT ux = tile.ptr(BIdx::ux);
+        amrex::ParticleReal const* const AMREX_RESTRICT uy = tile.ptr(BIdx::uy);
+        amrex::ParticleReal const* const AMREX_RESTRICT uz = tile.ptr(BIdx::uz);
+
+        amrex::Array4<amrex::Real> const& jx_arr = tile.J[0].array();
+        amrex::Array4<amrex::Real> const& jy_arr = tile.J[1].array();
+        amrex::Array4<amrex::Real> const& jz_arr = tile.J[2].array();
+        amrex::IntVect const jx_type = tile.J[0].box().type();
+        amrex::IntVect const jy_type = tile.J[1].box().type();
+        amrex::IntVect const jz_type = tile.J[2].box().type();
+
+        const amrex::XDim3 dinv = InvCellSize(tile);
+        const amrex::XDim3 xyzmin{0._rt, 0._rt, 0._rt};
+        const amrex::Dim3 lo = amrex::lbound(tile.box);
+        const amrex::Real invvol = dinv.x*dinv.y*dinv.z;
+        constexpr amrex::Real clightsq = 1.0_rt/PhysConst::c/PhysConst::c;
+
+        amrex::ParallelFor(tile.np,
+            [=] AMREX_GPU_DEVICE (long ip) {
+                const amrex::Real gaminv = 1.0_rt/std::sqrt(1.0_rt + ux[ip]*ux[ip]*clightsq
+                                                            + uy[ip]*uy[ip]*clightsq
+                                                            + uz[ip]*uz[ip]*clightsq);
+                doDepositionShapeNKernel<depos_order>(x[ip], y[ip], z[ip], charge*w[ip],
+                                                      ux[ip]*gaminv, uy[ip]*gaminv, uz[ip]*gaminv,
+                                                      jx_arr, jy_arr, jz_arr,
+                                                      jx_type, jy_type, jz_type,
+                                                      0._rt, dinv, xyzmin, invvol, lo, 1);
+            });
+    }
+
+    void Gather (Tile& tile, int const shape_order)
+    {
+        amrex::ParticleReal const* const AMREX_RESTRICT x = tile.ptr(BIdx::x);
+        amrex::ParticleReal const* const AMREX_RESTRICT y = tile.ptr(BIdx::y);
+        amrex::ParticleReal const* const AMREX_RESTRICT z = tile.ptr(BIdx::z);
+        amrex::ParticleReal* const AMREX_RESTRICT Exp = tile.ptr(BIdx::Ex);
+        amrex::ParticleReal* const AMREX_RESTRICT Eyp = tile.ptr(BIdx::Ey);
+        amrex::ParticleReal* const AMREX_RESTRICT Ezp = tile.ptr(BIdx::Ez);
+        amrex::ParticleReal* const AMREX_RESTRICT Bxp = tile.ptr(BIdx::Bx);
+        amrex::ParticleReal* const AMREX_RESTRICT Byp = tile.ptr(BIdx::By);
+        amrex::ParticleReal* const AMREX_RESTRICT Bzp = tile.ptr(BIdx::Bz);
+
+        amrex::Array4<amrex::Real const> const& ex_arr = tile.E[0].const_array();
+        amrex::Array4<amrex::Real const> const& ey_arr = tile.E[1].const_array();
+        amrex::Array4<amrex::Real const> const& ez_arr = tile.E[2].const_array();
+        amrex::Array4<amrex::Real const> const& bx_arr = tile.B[0].const_array();
+        amrex::Array4<amrex::Real const> const& by_arr = tile.B[1].const_array();
+        amrex::Array4<amrex::Real const> const& bz_arr = tile.B[2].const_array();
+        amrex::IndexType const ex_type = tile.E[0].box().ixType();
+        amrex::IndexType const ey_type = tile.E[1].box().ixType();
+        amrex::IndexType const ez_type = tile.E[2].box().ixType();
+        amrex::IndexType const bx_type = tile.B[0].box().ixType();
+        amrex::IndexType const by_type = tile.B[1].box().ixType();
+        amrex::IndexType const bz_type = tile.B[2].box().ixType();
+
+        const amrex::XDim3 dinv = InvCellSize(tile);
+        const amrex::XDim3 xyzmin{0._rt, 0._rt, 0._rt};
+        const amrex::Dim3 lo = amrex::lbound(tile.box);
+
+        amrex::ParallelFor(tile.np,
+            [=] AMREX_GPU_DEVICE (long ip) {
+                amrex::ParticleReal Ex = 0._prt, Ey = 0._prt, Ez = 0._prt;
+                amrex::ParticleReal Bx = 0._prt, By = 0._prt, Bz = 0._prt;
+                doGatherShapeN(x[ip], y[ip], z[ip], Ex, Ey, Ez, Bx, By, Bz,
+                               ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
+                               ex_type, ey_type, ez_type, bx_type, by_type, bz_type,
+                               dinv, xyzmin, lo, 1, shape_order, false);
+                Exp[ip] = Ex; Eyp[ip] = Ey; Ezp[ip] = Ez;
+                Bxp[ip] = Bx; Byp[ip] = By; Bzp[ip] = Bz;
+            });
+    }
+
+    enum struct Pusher { Boris, Vay, HigueraCary };
+
+    template <Pusher pusher>
+    void PushMomentum (Tile& tile, amrex::Real const dt)
+    {
+        amrex::ParticleReal* const AMREX_RESTRICT ux = tile.ptr(BIdx::ux);
+        amrex::ParticleReal* const AMREX_RESTRICT uy = tile.ptr(BIdx::uy);
+        amrex::ParticleReal* const AMREX_RESTRICT uz = tile.ptr(BIdx::uz);
+        amrex::ParticleReal const* const AMREX_RESTRICT Ex = tile.ptr(BIdx::Ex);
+        amrex::ParticleReal const* const AMREX_RESTRICT Ey = tile.ptr(BIdx::Ey);
+        amrex::ParticleReal const* const AMREX_RESTRICT Ez = tile.ptr(BIdx::Ez);
+        amrex::ParticleReal const* const AMREX_RESTRICT Bx = tile.ptr(BIdx::Bx);
+        amrex::ParticleReal const* const AMREX_RESTRICT By = tile.ptr(BIdx::By);
+        amrex::ParticleReal const* const AMREX_RESTRICT Bz = tile.ptr(BIdx::Bz);
+
+        amrex::ParallelFor(tile.np,
+            [=] AMREX_GPU_DEVICE (long ip) {
+                if constexpr (pusher == Pusher::Boris) {
+                    UpdateMomentumBoris(ux[ip], uy[ip], uz[ip], Ex[ip], Ey[ip], Ez[ip],
+                                        Bx[ip], By[ip], Bz[ip], charge, mass, dt);
+                } else if constexpr (pusher == Pusher::Vay) {
+                    UpdateMomentumVay(ux[ip], uy[ip], uz[ip], Ex[ip], Ey[ip], Ez[ip],
+                                      Bx[ip], By[ip], Bz[ip], charge, mass, dt);
+                } else {
+                    UpdateMomentumHigueraCary(ux[ip], uy[ip], uz[ip], Ex[ip], Ey[ip], Ez[ip],
+                                              Bx[ip], By[ip], Bz[ip], charge, mass, dt);
+                }
+            });
+    }
+
+#if !defined(WARPX_DIM_RZ)
+    /** Update of B and then of E with the Cartesian Yee algorithm, as in FiniteDifferenceSolver */
+    void YeeUpdate (Tile& tile, amrex::Real const dt)
+    {
+        using T_Algo = CartesianYeeAlgorithm;
+
+        amrex::Array4<amrex::Real> const& Ex = tile.E[0].array();
+        amrex::Array4<amrex::Real> const& Ey = tile.E[1].array();
+        amrex::Array4<amrex::Real> const& Ez = tile.E[2].array();
+        amrex::Array4<amrex::Real> const& Bx = tile.B[0].array();
+        amrex::Array4<amrex::Real> const& By = tile.B[1].array();
+        amrex::Array4<amrex::Real> const& Bz = tile.B[2].array();
+        amrex::Array4<amrex::Real> const& jx = tile.J[0].array();
+        amrex::Array4<amrex::Real> const& jy = tile.J[1].array();
+        amrex::Array4<amrex::Real> const& jz = tile.J[2].array();
+
+        const amrex::Real inv_dx = 1._rt/tile.dx;
+        amrex::Real const coefs[1] = {inv_dx};
+        amrex::Gpu::DeviceVector<amrex::Real> d_coefs(1);
+        amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, coefs, coefs + 1, d_coefs.begin());
+        amrex::Real const * const AMREX_RESTRICT coefs_x = d_coefs.dataPtr();
+        amrex::Real const * const AMREX_RESTRICT coefs_y = d_coefs.dataPtr();
+        amrex::Real const * const AMREX_RESTRICT coefs_z = d_coefs.dataPtr();
+        constexpr int n_coefs_x = 1;
+        constexpr int n_coefs_y = 1;
+        constexpr int n_coefs_z = 1;
+
+        const amrex::Box tbx = amrex::convert(tile.box, tile.B[0].box().ixType());
+        const amrex::Box tby = amrex::convert(tile.box, tile.B[1].box().ixType());
+        const amrex::Box tbz = amrex::convert(tile.box, tile.B[2].box().ixType());
+        amrex::ParallelFor(tbx, tby, tbz,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                Bx(i, j, k) += dt * T_Algo::UpwardDz(Ey, coefs_z, n_coefs_z, i, j, k)
+                             - dt * T_Algo::UpwardDy(Ez, coefs_y, n_coefs_y, i, j, k);
+            },
+            [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                By(i, j, k) += dt * T_Algo::UpwardDx(Ez, coefs_x, n_coefs_x, i, j, k)
+                             - dt * T_Algo::UpwardDz(Ex, coefs_z, n_coefs_z, i, j, k);
+            },
+            [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                Bz(i, j, k) += dt * T_Algo::UpwardDy(Ex, coefs_y, n_coefs_y, i, j, k)
+                             - dt * T_Algo::UpwardDx(Ey, coefs_x, n_coefs_x, i, j, k);
+            });
+
+        constexpr amrex::Real c2 = PhysConst::c * PhysConst::c;
+        const amrex::Box tex = amrex::convert(tile.box, tile.E[0].box().ixType());
+        const amrex::Box tey = amrex::convert(tile.box, tile.E[1].box().ixType());
+        const amrex::Box tez = amrex::convert(tile.box, tile.E[2].box().ixType());
+        amrex::ParallelFor(tex, tey, tez,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                Ex(i, j, k) += c2 * dt * (
+                    - T_Algo::DownwardDz(By, coefs_z, n_coefs_z, i, j, k)
+                    + T_Algo::DownwardDy(Bz, coefs_y, n_coefs_y, i, j, k)
+                    - PhysConst::mu0 * jx(i, j, k) );
+            },
+            [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                Ey(i, j, k) += c2 * dt * (
+                    - T_Algo::DownwardDx(Bz, coefs_x, n_coefs_x, i, j, k)
+                    + T_Algo::DownwardDz(Bx, coefs_z, n_coefs_z, i, j, k)
+                    - PhysConst::mu0 * jy(i, j, k) );
+            },
+            [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                Ez(i, j, k) += c2 * dt * (
+                    - T_Algo::DownwardDy(Bx, coefs_y, n_coefs_y, i, j, k)
+                    + T_Algo::DownwardDx(By, coefs_x, n_coefs_x, i, j, k)
+                    - PhysConst::mu0 * jz(i, j, k) );
+            });
+        // Keep d_coefs alive until the kernels are done
+        amrex::Gpu::streamSynchronize();
+    }
+#endif
+
+    /** Average time of one call of f, after one warm-up call */
+    template <typename F>
+    double TimeKernel (int const repetitions, F&& f)
+    {
+        f();
+        amrex::Gpu::streamSynchronize();
+        const double t0 = amrex::second();
+        for (int irep = 0; irep < repetitions; ++irep) { f(); }
+        amrex::Gpu::streamSynchronize();
+        return (amrex::second() - t0)/repetitions;
+    }
+
+    std::string PrecisionName (std::size_t const nbytes)
+    {
+        return (nbytes == sizeof(float)) ? "single" : "double";
+    }
+
+    std::string ComputeName ()
+    {
+#if defined(AMREX_USE_CUDA)
+        return "CUDA";
+#elif defined(AMREX_USE_HIP)
+        return "HIP";
+#elif defined(AMREX_USE_SYCL)
+        return "SYCL";
+#elif defined(AMREX_USE_OMP)
+        return "OMP";
+#else
+        return "NOACC";
+#endif
+    }
+
+    std::string DimsName ()
+    {
+#if defined(WARPX_DIM_3D)
+        return "3d";
+#elif defined(WARPX_DIM_XZ)
+        return "2d";
+#elif defined(WARPX_DIM_RZ)
+        return "rz";
+#else
+        return "1d";
+#endif
+    }
+
+    /**
+     * Result of one kernel, as a JSON line. items is the number of particles
+     * or grid points processed per call, bytes an estimate of the memory traffic
+     * per call (each array read or written once).
+     */
+    std::string FormatResult (BenchParams const& params, std::string const& kernel,
+                              long const items, double const bytes, double const time)
+    {
+        std::ostringstream os;
+        os.precision(6);
+        os << "{\"kernel\": \"" << kernel << "\""
+           << ", \"dims\": \"" << DimsName() << "\""
+           << ", \"compute\": \"" << ComputeName() << "\""
+           << ", \"precision\": \"" << PrecisionName(sizeof(amrex::Real)) << "\""
+           << ", \"particle_precision\": \"" << PrecisionName(sizeof(amrex::ParticleReal)) << "\""
+           << ", \"shape_order\": " << params.shape_order
+           << ", \"particles_per_cell\": " << params.ppc
+           << ", \"tile_size\": [";
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            os << (idim > 0 ? ", " : "") << params.tile_size[idim];
+        }
+        os << "], \"repetitions\": " << params.repetitions
+           << ", \"items\": " << items
+           << ", \"time_s\": " << time
+           << ", \"items_per_s\": " << items/time
+           << ", \"bytes\": " << bytes
+           << ", \"bytes_per_s\": " << bytes/time
+           << "}";
+        return os.str();
+    }
+
+    void RunBenchmarks (BenchParams const& params)
+    {
+        Tile tile;
+        InitTile(tile, params);
+
+        const amrex::Real dt = CartesianYeeAlgorithm::ComputeMaxDt(
+            std::array<amrex::Real,AMREX_SPACEDIM>{AMREX_D_DECL(tile.dx, tile.dx, tile.dx)}.data());
+        const auto npts = static_cast<double>(tile.box.numPts());
+        constexpr auto pr = static_cast<double>(sizeof(amrex::ParticleReal));
+        constexpr auto rr = static_cast<double>(sizeof(amrex::Real));
+
+        std::vector<std::string> results;
+        for (auto const& kernel : params.kernels) {
+            long items = tile.np;
+            double bytes = 0.;
+            double time = 0.;
+            if (kernel == "deposition") {
+                // positions, weights and momenta; J read and written
+                bytes = tile.np*7*pr + 2*3*npts*rr;
+                time = TimeKernel(params.repetitions, [&] () {
+                    switch (params.shape_order) {
+                        case 1: Deposit<1>(tile); break;
+                        case 2: Deposit<2>(tile); break;
+                        case 3: Deposit<3>(tile); break;
+                        default: Deposit<4>(tile); break;
+                    }
+                });
+            } else if (kernel == "gather") {
+                // positions read and fields on the particles written; E and B read
+                bytes = tile.np*9*pr + 6*npts*rr;
+                time = TimeKernel(params.repetitions, [&] () { Gather(tile, params.shape_order); });
+            } else if (kernel == "push_boris") {
+                // momenta read and written, fields on the particles read
+                bytes = tile.np*12*pr;
+                time = TimeKernel(params.repetitions, [&] () { PushMomentum<Pusher::Boris>(tile, dt); });
+            } else if (kernel == "push_vay") {
+                bytes = tile.np*12*pr;
+                time = TimeKernel(params.repetitions, [&] () { PushMomentum<Pusher::Vay>(tile, dt); });
+            } else if (kernel == "push_higuera_cary") {
+                bytes = tile.np*12*pr;
+                time = TimeKernel(params.repetitions, [&] () { PushMomentum<Pusher::HigueraCary>(tile, dt); });
+            }
+#if !defined(WARPX_DIM_RZ)
+            else if (kernel == "yee") {
+                // B: B read and written, E read; E: E read and written, B and J read
+                items = tile.box.numPts();
+                bytes = 21*npts*rr;
+                time = TimeKernel(params.repetitions, [&] () { YeeUpdate(tile, dt); });
+            }
+#   if defined(WARPX_USE_FFT)
+            else if (kernel == "fft") {
+                // Forward and backward transform of one field component
+                const amrex::BoxArray ba(tile.box);
+                const amrex::DistributionMapping dm(amrex::Vector<int>{amrex::ParallelDescriptor::MyProc()});
+                const SpectralKSpace k_space(ba, dm, amrex::RealVect(tile.dx));
+                SpectralFieldData spectral_data(0, ba, k_space, dm, 1, false);
+                amrex::MultiFab mf(amrex::convert(ba, tile.E[0].box().ixType()), dm, 1, 0);
+                mf.setVal(1._rt);
+                const auto nk = static_cast<double>(spectral_data.fields.boxArray()[0].numPts());
+                items = tile.box.numPts();
+                bytes = 2*(npts*rr + nk*sizeof(Complex));
+                time = TimeKernel(params.repetitions, [&] () {
+                    spectral_data.ForwardTransform(0, mf, 0, 0);
+                    spectral_data.BackwardTransform(0, mf, 0, amrex::IntVect(0), 0);
+                });
+            }
+#   endif
+#endif
+            results.push_back(FormatResult(params, kernel, items, bytes, time));
+        }
+
+        if (!amrex::ParallelDescriptor::IOProcessor()) { return; }
+        if (params.output.empty()) {
+            for (auto const& r : results) { amrex::Print() << r << "\n"; }
+        } else {
+            std::ofstream ofs(params.output, std::ios::app);
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(ofs.is_open(),
+                "Could not open " + params.output);
+            for (auto const& r : results) { ofs << r << "\n"; }
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    warpx::initialization::initialize_external_libraries(argc, argv);
+    {
+        const BenchParams params = ReadParameters();
+        RunBenchmarks(params);
+    }
+    warpx::initialization::finalize_external_libraries();
+}
@@ -441,6 +441,7 @@ function(warpx_print_summary)
     message("  Build options:")
     message("    APP: ${WarpX_APP}")
     message("    ASCENT: ${WarpX_ASCENT}")
+    message("    BENCHMARKS: ${WarpX_BENCHMARKS}")
     message("    COMPUTE: ${WarpX_COMPUTE}")
     message("    DIMS: ${WarpX_DIMS}")
     message("    Embedded Boundary: ${WarpX_EB}")